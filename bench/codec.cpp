@@ -0,0 +1,95 @@
+// 编解码微基准：utils::codec vs Drogon 标量 base64 / 原有逐字符 hex 编码
+// 构建：cmake -DBUILD_BENCHMARKS=ON，运行 ./codec_bench [iterations]
+// 输入长度覆盖 Token 段（32 B / 256 B）与消息体（4 KiB）
+
+#include "utils/Codec.hpp"
+#include <drogon/utils/Utilities.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // 防止结果被优化掉
+    volatile size_t sink = 0;
+
+    // 替换前 Span / Tracer 中的 hex 编码
+    std::string legacyHexEncode(const unsigned char* data, size_t size) {
+        static constexpr char hex[] = "0123456789abcdef";
+        std::string out;
+        out.reserve(size * 2);
+        for (size_t i = 0; i < size; ++i) {
+            out += hex[data[i] >> 4];
+            out += hex[data[i] & 0xF];
+        }
+        return out;
+    }
+
+    template <typename Op>
+    double measure(size_t iterations, Op&& op) {
+        // 预热
+        for (size_t i = 0; i < iterations / 10 + 1; ++i) {
+            sink = sink + op();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            sink = sink + op();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(iterations);
+    }
+
+    void report(const char* op, size_t size, double baseline, double codec) {
+        std::printf("%-14s %6zu B %12.1f ns %12.1f ns %8.1fx\n", op, size, baseline, codec, baseline / codec);
+    }
+
+    void runSize(size_t size, size_t iterations) {
+        std::vector<unsigned char> data(size);
+        std::mt19937_64 rng(size);
+        for (auto& b : data) {
+            b = static_cast<unsigned char>(rng());
+        }
+
+        const std::string encoded = drogon::utils::base64Encode(data.data(), data.size());
+        std::string out(utils::codec::base64EncodedLength(size, true) + size * 2, '\0');
+        std::vector<unsigned char> decoded(size);
+
+        // 大输入按字节数缩减迭代次数，保持每项耗时相近
+        const size_t n = std::max<size_t>(1000, iterations * 32 / size);
+
+        report("base64 encode", size,
+               measure(n, [&]() { return drogon::utils::base64Encode(data.data(), data.size()).size(); }),
+               measure(n, [&]() { return utils::codec::base64Encode(data.data(), data.size(), out.data()); }));
+
+        report("base64 decode", size,
+               measure(n, [&]() { return drogon::utils::base64Decode(encoded).size(); }),
+               measure(n, [&]() {
+                   return utils::codec::base64Decode(encoded, decoded.data(), decoded.size()).value_or(0);
+               }));
+
+        report("hex encode", size,
+               measure(n, [&]() { return legacyHexEncode(data.data(), data.size()).size(); }),
+               measure(n, [&]() {
+                   utils::codec::hexEncode(data.data(), data.size(), out.data());
+                   return static_cast<size_t>(out[0]);
+               }));
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::printf("codec implementation: %s\n", utils::codec::implementation());
+    std::printf("%-14s %8s %15s %15s %9s\n", "op", "size", "baseline", "utils::codec", "speedup");
+
+    for (size_t size : {32, 256, 4096}) {
+        runSize(size, iterations);
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+// JWT 验证微基准：自签 HS256 快速路径 vs jwt-cpp 完整解析
+// 构建：cmake -DBUILD_BENCHMARKS=ON，运行 ./jwt_verify_bench [iterations]
+// 通过替换全局 operator new 统计每次验证的堆分配次数（OpenSSL 内部的 malloc 不计入）
+
+#include "middleware/JwtFastPath.hpp"
+#include <jwt-cpp/jwt.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+
+namespace {
+
+    std::atomic<uint64_t> allocations{0};
+
+    constexpr const char* SECRET = "bench-secret-key";
+    constexpr const char* ISSUER = "drogon-scaffold";
+
+    // 与 JwtUtil::generate 相同的声明集合
+    std::string makeToken() {
+        auto now = std::chrono::system_clock::now();
+        return jwt::create()
+            .set_issuer(ISSUER)
+            .set_type("JWT")
+            .set_key_id("k1")
+            .set_id("AAECAwQFBgcICQoLDA0ODw")
+            .set_issued_at(now)
+            .set_expires_at(now + std::chrono::hours(1))
+            .set_payload_claim("userId", jwt::claim(std::string("1024")))
+            .set_payload_claim("username", jwt::claim(std::string("bench_user")))
+            .set_payload_claim("role", jwt::claim(std::string("admin")))
+            .sign(jwt::algorithm::hs256{SECRET});
+    }
+
+    // 与 JwtUtil::verifyFast 调用同一组 jwtfast 入口（不含按 kid 查表与写入 JwtPayload）
+    bool verifyFast(std::string_view token) {
+        middleware::jwtfast::Decoded decoded;
+        if (!middleware::jwtfast::decodeHeader(token, decoded) || decoded.header.kid != "k1") {
+            return false;
+        }
+        const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        return middleware::jwtfast::verifyToken(SECRET, ISSUER, now, decoded) ==
+               middleware::jwtfast::Result::Verified;
+    }
+
+    // 原有路径：jwt-cpp 解码 + 验证器 + 读取声明
+    bool verifyJwtCpp(const std::string& token) {
+        static const auto verifier = jwt::verify()
+            .allow_algorithm(jwt::algorithm::hs256{SECRET})
+            .with_issuer(ISSUER);
+        try {
+            auto decoded = jwt::decode(token);
+            verifier.verify(decoded);
+            return !decoded.get_payload_claim("userId").as_string().empty() &&
+                   !decoded.get_payload_claim("username").as_string().empty() &&
+                   !decoded.get_payload_claim("role").as_string().empty();
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    template <typename Verify>
+    void run(const char* name, size_t iterations, Verify&& verify) {
+        // 预热
+        for (size_t i = 0; i < iterations / 10 + 1; ++i) {
+            if (!verify()) {
+                std::fprintf(stderr, "%s: verification failed\n", name);
+                std::exit(1);
+            }
+        }
+
+        const uint64_t before = allocations.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            verify();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const uint64_t allocated = allocations.load(std::memory_order_relaxed) - before;
+
+        const double ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(iterations);
+        std::printf("%-10s %10.1f ns/op %8.2f allocs/op\n",
+                    name, ns, static_cast<double>(allocated) / static_cast<double>(iterations));
+    }
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    const auto token = makeToken();
+    std::printf("token: %zu bytes, %zu iterations\n", token.size(), iterations);
+
+    run("fast-path", iterations, [&token]() { return verifyFast(token); });
+    run("jwt-cpp", iterations, [&token]() { return verifyJwtCpp(token); });
+    return 0;
+}
@@ -1,9 +1,10 @@
 #include "AuthController.hpp"
 #include "services/AuthService.hpp"
-#include "middleware/JwtFilter.hpp"
+#include "middleware/AuthContext.hpp"
 #include "core/Response.hpp"
 #include "core/Exception.hpp"
 #include "lock/UserLock.hpp"
+#include "trace/Span.hpp"
 #include <spdlog/spdlog.h>
 
 namespace controllers {
@@ -22,7 +23,7 @@ drogon::Task<> AuthController::registerUser(drogon::HttpRequestPtr req,
         auto email = (*json)["email"].asString();
 
         auto& authService = services::AuthService::instance();
-        auto result = co_await authService.registerUser(username, password, email);
+        auto result = co_await authService.registerUser(username, password, email, trace::contextOf(req));
 
         Json::Value data;
         data["userId"] = static_cast<Json::Int64>(result.userId);
@@ -51,7 +52,7 @@ drogon::Task<> AuthController::login(drogon::HttpRequestPtr req,
         auto password = (*json)["password"].asString();
 
         auto& authService = services::AuthService::instance();
-        auto result = co_await authService.login(username, password);
+        auto result = co_await authService.login(username, password, trace::contextOf(req));
 
         Json::Value data;
         data["userId"] = static_cast<Json::Int64>(result.userId);
@@ -72,12 +73,12 @@ drogon::Task<> AuthController::login(drogon::HttpRequestPtr req,
 drogon::Task<> AuthController::logout(drogon::HttpRequestPtr req,
                                        std::function<void(const drogon::HttpResponsePtr&)> callback) {
     try {
-        auto userIdStr = req->getAttributes()->get<std::string>("userId");
-        int64_t userId = std::stoll(userIdStr);
-        auto token = middleware::JwtUtil::extractToken(req).value_or("");
+        const auto& auth = middleware::AuthContext::from(req);
+        const int64_t userId = auth.userId;
+        const auto userIdStr = std::to_string(userId);
 
         // 用户锁：串行处理
-        auto lockValue = co_await lock::UserLock::instance().lock(userIdStr);
+        auto lockValue = co_await lock::UserLock::instance().lock(userIdStr, trace::contextOf(req));
         if (lockValue.empty()) {
             callback(core::Response::error(core::ErrorCode::RATE_LIMIT_EXCEEDED));
             co_return;
@@ -86,10 +87,13 @@ drogon::Task<> AuthController::logout(drogon::HttpRequestPtr req,
         auto guard = lock::UserLockGuard(userIdStr, lockValue);
 
         auto& authService = services::AuthService::instance();
-        co_await authService.logout(userId, token);
+        co_await authService.logout(userId, auth.tokenId,
+                                    std::chrono::system_clock::time_point(
+                                        std::chrono::system_clock::duration(auth.exp)),
+                                    trace::contextOf(req));
 
-        co_await guard.release();
         callback(core::Response::successMsg("logged out"));
+        guard.releaseDeferred();
 
     } catch (const core::AppException& e) {
         callback(core::Response::fromException(e));
@@ -102,11 +106,11 @@ drogon::Task<> AuthController::logout(drogon::HttpRequestPtr req,
 drogon::Task<> AuthController::refresh(drogon::HttpRequestPtr req,
                                         std::function<void(const drogon::HttpResponsePtr&)> callback) {
     try {
-        auto userIdStr = req->getAttributes()->get<std::string>("userId");
-        int64_t userId = std::stoll(userIdStr);
+        const int64_t userId = middleware::AuthContext::from(req).userId;
+        const auto userIdStr = std::to_string(userId);
 
         // 用户锁：串行处理
-        auto lockValue = co_await lock::UserLock::instance().lock(userIdStr);
+        auto lockValue = co_await lock::UserLock::instance().lock(userIdStr, trace::contextOf(req));
         if (lockValue.empty()) {
             callback(core::Response::error(core::ErrorCode::RATE_LIMIT_EXCEEDED));
             co_return;
@@ -115,7 +119,7 @@ drogon::Task<> AuthController::refresh(drogon::HttpRequestPtr req,
         auto guard = lock::UserLockGuard(userIdStr, lockValue);
 
         auto& authService = services::AuthService::instance();
-        auto result = co_await authService.refreshToken(userId);
+        auto result = co_await authService.refreshToken(userId, trace::contextOf(req));
 
         Json::Value data;
         data["userId"] = static_cast<Json::Int64>(result.userId);
@@ -123,8 +127,8 @@ drogon::Task<> AuthController::refresh(drogon::HttpRequestPtr req,
         data["token"] = result.token;
         data["expiresAt"] = static_cast<Json::Int64>(result.expiresAt);
 
-        co_await guard.release();
         callback(core::Response::success(data));
+        guard.releaseDeferred();
 
     } catch (const core::AppException& e) {
         callback(core::Response::fromException(e));
@@ -137,8 +141,8 @@ drogon::Task<> AuthController::refresh(drogon::HttpRequestPtr req,
 drogon::Task<> AuthController::changePassword(drogon::HttpRequestPtr req,
                                                std::function<void(const drogon::HttpResponsePtr&)> callback) {
     try {
-        auto userIdStr = req->getAttributes()->get<std::string>("userId");
-        int64_t userId = std::stoll(userIdStr);
+        const int64_t userId = middleware::AuthContext::from(req).userId;
+        const auto userIdStr = std::to_string(userId);
 
         auto json = req->getJsonObject();
         if (!json) {
@@ -150,7 +154,7 @@ drogon::Task<> AuthController::changePassword(drogon::HttpRequestPtr req,
         auto newPassword = (*json)["newPassword"].asString();
 
         // 用户锁：串行处理
-        auto lockValue = co_await lock::UserLock::instance().lock(userIdStr);
+        auto lockValue = co_await lock::UserLock::instance().lock(userIdStr, trace::contextOf(req));
         if (lockValue.empty()) {
             callback(core::Response::error(core::ErrorCode::RATE_LIMIT_EXCEEDED));
             co_return;
@@ -159,10 +163,10 @@ drogon::Task<> AuthController::changePassword(drogon::HttpRequestPtr req,
         auto guard = lock::UserLockGuard(userIdStr, lockValue);
 
         auto& authService = services::AuthService::instance();
-        co_await authService.changePassword(userId, oldPassword, newPassword);
+        co_await authService.changePassword(userId, oldPassword, newPassword, trace::contextOf(req));
 
-        co_await guard.release();
         callback(core::Response::successMsg("password changed"));
+        guard.releaseDeferred();
 
     } catch (const core::AppException& e) {
         callback(core::Response::fromException(e));
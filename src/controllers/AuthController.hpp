@@ -13,13 +13,13 @@ namespace controllers {
         ADD_METHOD_TO(AuthController::login, "/api/auth/login", drogon::Post);
         // 登出（需要 JWT）
         ADD_METHOD_TO(AuthController::logout, "/api/auth/logout", drogon::Post,
-                      "middleware::JwtFilter", "middleware::LogFilter");
+                      "middleware::JwtFilter", "middleware::AuthzFilter", "middleware::LogFilter");
         // 刷新 Token（需要 JWT）
         ADD_METHOD_TO(AuthController::refresh, "/api/auth/refresh", drogon::Post,
-                      "middleware::JwtFilter", "middleware::LogFilter");
+                      "middleware::JwtFilter", "middleware::AuthzFilter", "middleware::LogFilter");
         // 修改密码（需要 JWT）
         ADD_METHOD_TO(AuthController::changePassword, "/api/auth/password", drogon::Put,
-                      "middleware::JwtFilter", "middleware::LogFilter");
+                      "middleware::JwtFilter", "middleware::AuthzFilter", "middleware::LogFilter");
         METHOD_LIST_END
 
         // 注册
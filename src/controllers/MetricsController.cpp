@@ -0,0 +1,21 @@
+#include "MetricsController.hpp"
+#include "metrics/HttpMetrics.hpp"
+#include "metrics/RuntimeMonitor.hpp"
+
+namespace controllers {
+
+drogon::Task<> MetricsController::metrics(drogon::HttpRequestPtr req,
+                                          std::function<void(const drogon::HttpResponsePtr&)> callback) {
+    std::string body;
+    body.reserve(16 * 1024);
+    metrics::HttpMetrics::instance().render(body);
+    metrics::RuntimeMonitor::instance().render(body);
+
+    auto resp = drogon::HttpResponse::newHttpResponse();
+    resp->setContentTypeString("text/plain; version=0.0.4; charset=utf-8");
+    resp->setBody(std::move(body));
+    callback(resp);
+    co_return;
+}
+
+} // namespace controllers
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <drogon/HttpController.h>
+
+namespace controllers {
+
+    class MetricsController : public drogon::HttpController<MetricsController> {
+    public:
+        METHOD_LIST_BEGIN
+            // Prometheus 抓取端点
+            ADD_METHOD_TO(MetricsController::metrics, "/metrics", drogon::Get);
+        METHOD_LIST_END
+
+        // 输出 Prometheus 文本格式指标
+        drogon::Task<> metrics(drogon::HttpRequestPtr req,
+                               std::function<void(const drogon::HttpResponsePtr&)> callback);
+    };
+
+} // namespace controllers
\ No newline at end of file
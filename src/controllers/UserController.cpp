@@ -4,6 +4,9 @@
 #include "core/Exception.hpp"
 #include "core/Constants.hpp"
 #include "lock/UserLock.hpp"
+#include "trace/Span.hpp"
+#include "middleware/AuthContext.hpp"
+#include "middleware/AuthzFilter.hpp"
 #include <spdlog/spdlog.h>
 
 namespace controllers {
@@ -11,11 +14,10 @@ namespace controllers {
 drogon::Task<> UserController::getCurrentUser(drogon::HttpRequestPtr req,
                                                std::function<void(const drogon::HttpResponsePtr&)> callback) {
     try {
-        auto userIdStr = req->getAttributes()->get<std::string>("userId");
-        int64_t userId = std::stoll(userIdStr);
+        const int64_t userId = middleware::AuthContext::from(req).userId;
 
         auto& userService = services::UserService::instance();
-        auto user = co_await userService.getUserById(userId);
+        auto user = co_await userService.getUserById(userId, trace::contextOf(req));
 
         callback(core::Response::success(user.toJsonForApi()));
 
@@ -39,7 +41,23 @@ drogon::Task<> UserController::listUsers(drogon::HttpRequestPtr req,
         int pageSize = pageSizeStr.empty() ? core::constants::DEFAULT_PAGE_SIZE : std::stoi(pageSizeStr);
 
         auto& userService = services::UserService::instance();
-        auto result = co_await userService.listUsers(page, pageSize, keyword);
+
+        // 带 cursor 参数（可为空，表示第一页）时走游标分页，深翻页不退化
+        const auto& params = req->getParameters();
+        if (params.find("cursor") != params.end()) {
+            auto result = co_await userService.listUsersAfter(req->getParameter("cursor"), pageSize,
+                                                              keyword, trace::contextOf(req));
+
+            Json::Value list(Json::arrayValue);
+            for (const auto& user : result.list) {
+                list.append(user.toJsonForApi());
+            }
+
+            callback(core::Response::cursorPage(list, result.nextCursor, result.pageSize));
+            co_return;
+        }
+
+        auto result = co_await userService.listUsers(page, pageSize, keyword, trace::contextOf(req));
 
         // 构建列表 JSON
         Json::Value list(Json::arrayValue);
@@ -47,7 +65,8 @@ drogon::Task<> UserController::listUsers(drogon::HttpRequestPtr req,
             list.append(user.toJsonForApi());
         }
 
-        callback(core::Response::page(list, result.total, result.page, result.pageSize));
+        callback(core::Response::page(list, result.total, result.page, result.pageSize,
+                                      result.approximate));
 
     } catch (const core::AppException& e) {
         callback(core::Response::fromException(e));
@@ -62,7 +81,7 @@ drogon::Task<> UserController::getUserById(drogon::HttpRequestPtr req,
                                             int64_t id) {
     try {
         auto& userService = services::UserService::instance();
-        auto user = co_await userService.getUserById(id);
+        auto user = co_await userService.getUserById(id, trace::contextOf(req));
 
         callback(core::Response::success(user.toJsonForApi()));
 
@@ -84,9 +103,17 @@ drogon::Task<> UserController::updateUser(drogon::HttpRequestPtr req,
             co_return;
         }
 
+        // 修改角色需要额外权限（AuthzFilter 只区分 self / any）
+        if (json->isMember("role") &&
+            !middleware::hasPermission(middleware::AuthContext::from(req).role,
+                                       middleware::PERM_USER_ASSIGN_ROLE)) {
+            callback(core::Response::error(core::ErrorCode::PERMISSION_DENIED));
+            co_return;
+        }
+
         // 用户锁：串行处理
         auto lockKey = std::to_string(id);
-        auto lockValue = co_await lock::UserLock::instance().lock(lockKey);
+        auto lockValue = co_await lock::UserLock::instance().lock(lockKey, trace::contextOf(req));
         if (lockValue.empty()) {
             callback(core::Response::error(core::ErrorCode::RATE_LIMIT_EXCEEDED));
             co_return;
@@ -105,10 +132,10 @@ drogon::Task<> UserController::updateUser(drogon::HttpRequestPtr req,
         }
 
         auto& userService = services::UserService::instance();
-        co_await userService.updateUser(id, email, role);
+        co_await userService.updateUser(id, email, role, trace::contextOf(req));
 
-        co_await guard.release();
         callback(core::Response::successMsg("user updated"));
+        guard.releaseDeferred();
 
     } catch (const core::AppException& e) {
         callback(core::Response::fromException(e));
@@ -132,7 +159,7 @@ drogon::Task<> UserController::setUserStatus(drogon::HttpRequestPtr req,
 
         // 用户锁：串行处理
         auto lockKey = std::to_string(id);
-        auto lockValue = co_await lock::UserLock::instance().lock(lockKey);
+        auto lockValue = co_await lock::UserLock::instance().lock(lockKey, trace::contextOf(req));
         if (lockValue.empty()) {
             callback(core::Response::error(core::ErrorCode::RATE_LIMIT_EXCEEDED));
             co_return;
@@ -141,10 +168,10 @@ drogon::Task<> UserController::setUserStatus(drogon::HttpRequestPtr req,
         auto guard = lock::UserLockGuard(lockKey, lockValue);
 
         auto& userService = services::UserService::instance();
-        co_await userService.setUserStatus(id, status);
+        co_await userService.setUserStatus(id, status, trace::contextOf(req));
 
-        co_await guard.release();
         callback(core::Response::successMsg("status updated"));
+        guard.releaseDeferred();
 
     } catch (const core::AppException& e) {
         callback(core::Response::fromException(e));
@@ -160,7 +187,7 @@ drogon::Task<> UserController::deleteUser(drogon::HttpRequestPtr req,
     try {
         // 用户锁：串行处理
         auto lockKey = std::to_string(id);
-        auto lockValue = co_await lock::UserLock::instance().lock(lockKey);
+        auto lockValue = co_await lock::UserLock::instance().lock(lockKey, trace::contextOf(req));
         if (lockValue.empty()) {
             callback(core::Response::error(core::ErrorCode::RATE_LIMIT_EXCEEDED));
             co_return;
@@ -169,10 +196,10 @@ drogon::Task<> UserController::deleteUser(drogon::HttpRequestPtr req,
         auto guard = lock::UserLockGuard(lockKey, lockValue);
 
         auto& userService = services::UserService::instance();
-        co_await userService.deleteUser(id);
+        co_await userService.deleteUser(id, trace::contextOf(req));
 
-        co_await guard.release();
         callback(core::Response::successMsg("user deleted"));
+        guard.releaseDeferred();
 
     } catch (const core::AppException& e) {
         callback(core::Response::fromException(e));
@@ -9,19 +9,30 @@ namespace core::constants {
     inline constexpr const char* JWT_SECRET = "your-secret-key-change-in-production";
     inline constexpr const char* JWT_ISSUER = "drogon-scaffold";
     inline constexpr auto JWT_EXPIRE_DURATION = std::chrono::hours(24);
+    inline constexpr size_t JWT_ID_BYTES = 16;  // jti 随机字节数（吊销键直接使用原始字节）
 
     // Redis Key 前缀
     inline constexpr const char* REDIS_PREFIX = "drogon:";
     inline constexpr const char* REDIS_TOKEN_PREFIX = "drogon:token:";
+    inline constexpr const char* REDIS_TOKEN_BLACKLIST_PREFIX = "drogon:token:blacklist:";
+    inline constexpr const char* REDIS_TOKEN_REVOKED_CHANNEL = "drogon:token:revoked";
     inline constexpr const char* REDIS_USER_LOCK_PREFIX = "drogon:lock:user:";
+    inline constexpr const char* REDIS_USER_LOCK_RELEASED_CHANNEL = "drogon:lock:released";
     inline constexpr const char* REDIS_QUEUE_PREFIX = "drogon:queue:";
 
     // 队列配置
     inline constexpr size_t QUEUE_MAX_SIZE = 10000;
     inline constexpr auto QUEUE_TIMEOUT = std::chrono::seconds(30);
 
-    // 用户锁配置
-    inline constexpr auto USER_LOCK_TIMEOUT = std::chrono::seconds(60);
+    // 用户锁配置（短租约，持有期间由看门狗续期）
+    inline constexpr auto USER_LOCK_TIMEOUT = std::chrono::seconds(5);
+
+    // Token 吊销过滤器配置
+    inline constexpr size_t REVOCATION_EXPECTED_ENTRIES = 100000;
+    inline constexpr double REVOCATION_FALSE_POSITIVE_RATE = 0.001;
+    inline constexpr auto REVOCATION_REBUILD_INTERVAL = std::chrono::hours(1);
+    inline constexpr auto REVOCATION_RETRY_BASE = std::chrono::seconds(1);   // 加载失败后的重试退避
+    inline constexpr auto REVOCATION_RETRY_MAX = std::chrono::seconds(60);
 
     // 分页默认值
     inline constexpr int DEFAULT_PAGE = 1;
@@ -32,5 +43,6 @@ namespace core::constants {
     inline constexpr const char* HEADER_AUTHORIZATION = "Authorization";
     inline constexpr const char* HEADER_BEARER_PREFIX = "Bearer ";
     inline constexpr const char* HEADER_REQUEST_ID = "X-Request-Id";
+    inline constexpr const char* HEADER_TRACEPARENT = "traceparent";
 
 } // namespace core::constants
\ No newline at end of file
@@ -49,17 +49,34 @@ public:
         return error(e.code(), e.fullMessage());
     }
 
-    // 分页响应
+    // 分页响应（approximate 表示 total 为估算值）
     static drogon::HttpResponsePtr page(const Json::Value& list,
                                         int64_t total,
                                         int page,
-                                        int pageSize) {
+                                        int pageSize,
+                                        bool approximate = false) {
         Json::Value data;
         data["list"] = list;
         data["total"] = static_cast<Json::Int64>(total);
         data["page"] = page;
         data["pageSize"] = pageSize;
         data["totalPages"] = static_cast<Json::Int64>((total + pageSize - 1) / pageSize);
+        if (approximate) {
+            data["totalApproximate"] = true;
+        }
+
+        return success(data);
+    }
+
+    // 游标分页响应（nextCursor 为空时返回 null）
+    static drogon::HttpResponsePtr cursorPage(const Json::Value& list,
+                                              const std::string& nextCursor,
+                                              int pageSize) {
+        Json::Value data;
+        data["list"] = list;
+        data["pageSize"] = pageSize;
+        data["nextCursor"] = nextCursor.empty() ? Json::Value() : Json::Value(nextCursor);
+        data["hasMore"] = !nextCursor.empty();
 
         return success(data);
     }
@@ -0,0 +1,121 @@
+#include "KeyedMutex.hpp"
+#include <drogon/drogon.h>
+
+namespace lock {
+
+// ==================== Awaiter ====================
+
+KeyedMutex::Awaiter::Awaiter(KeyedMutex& owner, std::string key,
+                             std::chrono::milliseconds timeout)
+    : owner_(owner)
+    , key_(std::move(key))
+    , timeout_(timeout) {
+}
+
+bool KeyedMutex::Awaiter::await_ready() {
+    return owner_.tryLock(key_);
+}
+
+bool KeyedMutex::Awaiter::await_suspend(std::coroutine_handle<> handle) {
+    auto* loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+    if (!loop) {
+        loop = drogon::app().getLoop();
+    }
+
+    auto waiter = std::make_shared<Waiter>();
+    waiter->handle = handle;
+    waiter->loop = loop;
+
+    // 是否挂起与登记等待者在同一把锁内决定，unlock / onTimeout 也持有这把锁才能取走等待者；
+    // 等待者入队即对其他线程可见，之后随时可能在 waiter->loop 上被恢复（当前线程没有事件循环时
+    // 就是主循环），所以入队是最后一步，之后不再访问 Awaiter 自身的任何成员
+    std::lock_guard<std::mutex> lk(owner_.mutex_);
+
+    // await_ready 之后锁可能已被释放，直接获取
+    auto [it, inserted] = owner_.holders_.try_emplace(key_);
+    if (inserted) {
+        return false;
+    }
+
+    // 超时计时器在等待者自己的循环上触发；回调需要同一把锁，入队前不会生效
+    auto* owner = &owner_;
+    waiter->timerId = loop->runAfter(
+        std::chrono::duration<double>(timeout_).count(),
+        [owner, key = key_, waiter]() {
+            owner->onTimeout(key, waiter);
+        });
+
+    waiter_ = waiter;
+    it->second.push_back(std::move(waiter));
+    return true;
+}
+
+bool KeyedMutex::Awaiter::await_resume() const noexcept {
+    return !waiter_ || waiter_->acquired;
+}
+
+// ==================== KeyedMutex ====================
+
+KeyedMutex::Awaiter KeyedMutex::lock(const std::string& key, std::chrono::milliseconds timeout) {
+    return Awaiter(*this, key, timeout);
+}
+
+bool KeyedMutex::tryLock(const std::string& key) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return holders_.try_emplace(key).second;
+}
+
+void KeyedMutex::unlock(const std::string& key) {
+    WaiterPtr next;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto it = holders_.find(key);
+        if (it == holders_.end()) {
+            return;
+        }
+
+        auto& waiters = it->second;
+        while (!waiters.empty()) {
+            auto waiter = std::move(waiters.front());
+            waiters.pop_front();
+            if (!waiter->done) {
+                // 所有权直接移交，key 保持持有状态
+                waiter->done = true;
+                waiter->acquired = true;
+                next = std::move(waiter);
+                break;
+            }
+        }
+
+        if (!next) {
+            holders_.erase(it);
+            return;
+        }
+    }
+
+    // 只在等待者自己的循环上恢复，与超时路径一致
+    next->loop->invalidateTimer(next->timerId);
+    next->loop->queueInLoop([handle = next->handle]() {
+        handle.resume();
+    });
+}
+
+void KeyedMutex::onTimeout(const std::string& key, const WaiterPtr& waiter) {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (waiter->done) {
+            return;
+        }
+        waiter->done = true;
+
+        if (auto it = holders_.find(key); it != holders_.end()) {
+            auto& waiters = it->second;
+            std::erase(waiters, waiter);
+        }
+    }
+
+    // 计时器回调本身就运行在等待者的循环上
+    waiter->handle.resume();
+}
+
+} // namespace lock
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <trantor/net/EventLoop.h>
+#include <coroutine>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace lock {
+
+    // 进程内按 key 划分的协程互斥锁（FIFO 排队，跨 IO 线程安全）
+    // 同一节点上对同一 key 的竞争者先在这里排队，只有持有者才去访问 Redis
+    class KeyedMutex {
+        struct Waiter;
+        using WaiterPtr = std::shared_ptr<Waiter>;
+
+    public:
+        // co_await 的结果为 true 表示已获取，false 表示等待超时
+        class Awaiter {
+        public:
+            Awaiter(KeyedMutex& owner, std::string key, std::chrono::milliseconds timeout);
+
+            bool await_ready();
+            bool await_suspend(std::coroutine_handle<> handle);
+            bool await_resume() const noexcept;
+
+        private:
+            KeyedMutex& owner_;
+            std::string key_;
+            std::chrono::milliseconds timeout_;
+            WaiterPtr waiter_;
+        };
+
+        KeyedMutex() = default;
+        KeyedMutex(const KeyedMutex&) = delete;
+        KeyedMutex& operator=(const KeyedMutex&) = delete;
+
+        // 获取锁（协程，FIFO 排队，带超时）
+        Awaiter lock(const std::string& key, std::chrono::milliseconds timeout);
+
+        // 尝试获取锁（非阻塞）
+        bool tryLock(const std::string& key);
+
+        // 释放锁；有等待者时直接移交给队首，并在其所属事件循环上恢复
+        void unlock(const std::string& key);
+
+    private:
+        // 等待者状态（由 mutex_ 保护）
+        struct Waiter {
+            std::coroutine_handle<> handle;
+            trantor::EventLoop* loop{nullptr};
+            trantor::TimerId timerId{0};
+            bool done{false};
+            bool acquired{false};
+        };
+
+        void onTimeout(const std::string& key, const WaiterPtr& waiter);
+
+        std::mutex mutex_;
+        // key 存在即表示已被持有，value 为排队中的等待者
+        std::unordered_map<std::string, std::deque<WaiterPtr>> holders_;
+    };
+
+} // namespace lock
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "LeaseWatchdog.hpp"
+#include "utils/Redis.hpp"
+#include "core/Exception.hpp"
+#include <drogon/drogon.h>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace lock {
+
+void LeaseWatchdog::setLease(std::chrono::milliseconds lease) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (lease == lease_) {
+        return;
+    }
+    lease_ = lease;
+
+    // 已在运行的续期定时器按新周期重新启动，否则仍按旧租约的 1/3 续期，可能在持有期间过期
+    for (auto& [loop, timerId] : timers_) {
+        loop->invalidateTimer(timerId);
+        timerId = arm(loop);
+    }
+}
+
+trantor::TimerId LeaseWatchdog::arm(trantor::EventLoop* loop) {
+    auto interval = std::chrono::duration<double>(lease_).count() / 3.0;
+    return loop->runEvery(interval, [this, loop]() {
+        renew(loop);
+    });
+}
+
+void LeaseWatchdog::add(const std::string& key, const std::string& value) {
+    auto* loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+    if (!loop) {
+        loop = drogon::app().getLoop();
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    leases_[key] = Lease{value, loop};
+
+    if (!timers_.contains(loop)) {
+        timers_[loop] = arm(loop);
+    }
+}
+
+void LeaseWatchdog::remove(const std::string& key, const std::string& value) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (auto it = leases_.find(key); it != leases_.end() && it->second.value == value) {
+        leases_.erase(it);
+    }
+}
+
+void LeaseWatchdog::renew(trantor::EventLoop* loop) {
+    std::vector<std::pair<std::string, std::string>> batch;
+    std::chrono::milliseconds ttl;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        ttl = lease_;
+        for (const auto& [key, lease] : leases_) {
+            if (lease.loop == loop) {
+                batch.emplace_back(key, lease.value);
+            }
+        }
+    }
+
+    if (batch.empty()) {
+        return;
+    }
+
+    drogon::async_run([this, batch = std::move(batch), ttl]() -> drogon::Task<void> {
+        std::vector<std::string> lost;
+        try {
+            lost = co_await utils::Redis::instance().renewLeases(batch, ttl);
+        } catch (const core::RedisException& e) {
+            // 续期失败不立即放弃，下个周期仍会重试（租约剩余 2/3）
+            spdlog::error("Failed to renew user lock leases: {}", e.what());
+            co_return;
+        }
+
+        // 值已不匹配（过期后被他人获取），不再续期
+        for (const auto& key : lost) {
+            spdlog::warn("User lock lease lost: key={}", key);
+            for (const auto& [k, v] : batch) {
+                if (k == key) {
+                    remove(k, v);
+                    break;
+                }
+            }
+        }
+    });
+}
+
+} // namespace lock
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <trantor/net/EventLoop.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace lock {
+
+    // 锁租约看门狗：持有期间由后台定时器按短租约续期
+    // 续期按事件循环分批，每个循环每个周期只发一次 Redis 脚本
+    class LeaseWatchdog {
+    public:
+        LeaseWatchdog() = default;
+        LeaseWatchdog(const LeaseWatchdog&) = delete;
+        LeaseWatchdog& operator=(const LeaseWatchdog&) = delete;
+
+        // 租约时长，续期周期为其 1/3（可随时调整，已启动的定时器会按新周期重新启动）
+        void setLease(std::chrono::milliseconds lease);
+
+        // 登记 / 注销一个持有中的锁
+        void add(const std::string& key, const std::string& value);
+        void remove(const std::string& key, const std::string& value);
+
+    private:
+        // 定时器回调：续期该循环上登记的所有租约
+        void renew(trantor::EventLoop* loop);
+
+        // 在 loop 上启动续期定时器（调用方持有 mutex_）
+        trantor::TimerId arm(trantor::EventLoop* loop);
+
+        struct Lease {
+            std::string value;
+            trantor::EventLoop* loop{nullptr};
+        };
+
+        std::mutex mutex_;
+        std::chrono::milliseconds lease_{5000};
+        // key -> 租约
+        std::unordered_map<std::string, Lease> leases_;
+        // 已启动续期定时器的循环
+        std::unordered_map<trantor::EventLoop*, trantor::TimerId> timers_;
+    };
+
+} // namespace lock
\ No newline at end of file
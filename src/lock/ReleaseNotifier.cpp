@@ -0,0 +1,77 @@
+#include "ReleaseNotifier.hpp"
+#include "utils/Redis.hpp"
+#include "core/Exception.hpp"
+#include <drogon/drogon.h>
+#include <spdlog/spdlog.h>
+
+namespace lock {
+
+void ReleaseNotifier::start(const std::string& channel) {
+    try {
+        subscriber_ = utils::Redis::instance().subscribe(channel, [this](const std::string& userId) {
+            notify(userId);
+        });
+        active_.store(true, std::memory_order_release);
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to subscribe user lock releases, fallback to polling: {}", e.what());
+    }
+}
+
+bool ReleaseNotifier::WaitAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    auto* current = trantor::EventLoop::getEventLoopOfCurrentThread();
+    waiter_ = std::make_shared<Waiter>();
+    waiter_->handle = handle;
+    waiter_->loop = current ? current : drogon::app().getLoop();
+
+    // 登记后协程可能随时在其他线程被恢复（当前线程没有事件循环时），之后只使用局部副本
+    auto waiter = waiter_;
+    auto& notifier = notifier_;
+    auto userId = userId_;
+    const double seconds = std::chrono::duration<double>(timeout_).count();
+
+    if (!notifier.enlist(userId, waiter)) {
+        return false;
+    }
+
+    waiter->loop->runAfter(seconds, [&notifier, userId = std::move(userId), waiter]() {
+        if (notifier.withdraw(userId, waiter)) {
+            waiter->handle.resume();
+        }
+    });
+    return true;
+}
+
+bool ReleaseNotifier::enlist(const std::string& userId, const std::shared_ptr<Waiter>& waiter) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return waiters_.try_emplace(userId, waiter).second;
+}
+
+bool ReleaseNotifier::withdraw(const std::string& userId, const std::shared_ptr<Waiter>& waiter) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = waiters_.find(userId);
+    if (it == waiters_.end() || it->second != waiter) {
+        return false;
+    }
+    waiters_.erase(it);
+    return true;
+}
+
+void ReleaseNotifier::notify(const std::string& userId) {
+    std::shared_ptr<Waiter> waiter;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto it = waiters_.find(userId);
+        if (it == waiters_.end()) {
+            return;
+        }
+        waiter = std::move(it->second);
+        waiters_.erase(it);
+    }
+
+    waiter->notified = true;
+    waiter->loop->queueInLoop([waiter]() {
+        waiter->handle.resume();
+    });
+}
+
+} // namespace lock
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <drogon/nosql/RedisClient.h>
+#include <trantor/net/EventLoop.h>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace lock {
+
+    // 锁释放通知：订阅 Redis 释放频道，把消息分发给本节点正在等待该用户锁的协程
+    // 订阅使用独立连接，等待期间不占用共享的命令连接
+    // 每个用户在本节点最多一个等待者（只有本地锁持有者才会等待 Redis 锁）
+    class ReleaseNotifier {
+    public:
+        struct Waiter {
+            std::coroutine_handle<> handle;
+            trantor::EventLoop* loop{nullptr};
+            bool notified{false};
+        };
+
+        // co_await 结果：true 表示收到释放通知，false 表示超时或无法等待
+        class WaitAwaiter {
+        public:
+            WaitAwaiter(ReleaseNotifier& notifier, std::string userId, std::chrono::milliseconds timeout)
+                : notifier_(notifier)
+                , userId_(std::move(userId))
+                , timeout_(timeout) {
+            }
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle);
+            bool await_resume() const noexcept { return waiter_ && waiter_->notified; }
+
+        private:
+            ReleaseNotifier& notifier_;
+            std::string userId_;
+            std::chrono::milliseconds timeout_;
+            std::shared_ptr<Waiter> waiter_;
+        };
+
+        ReleaseNotifier() = default;
+        ReleaseNotifier(const ReleaseNotifier&) = delete;
+        ReleaseNotifier& operator=(const ReleaseNotifier&) = delete;
+
+        // 订阅释放频道（需在 Redis 可用后调用）；失败时 active() 为 false，调用方退化为轮询
+        void start(const std::string& channel);
+
+        [[nodiscard]] bool active() const noexcept { return active_.load(std::memory_order_acquire); }
+
+        // 等待 userId 的释放通知，最多 timeout
+        WaitAwaiter wait(std::string userId, std::chrono::milliseconds timeout) {
+            return WaitAwaiter(*this, std::move(userId), timeout);
+        }
+
+    private:
+        // 收到释放消息
+        void notify(const std::string& userId);
+
+        // 登记等待者；已有等待者时返回 false
+        bool enlist(const std::string& userId, const std::shared_ptr<Waiter>& waiter);
+
+        // 取出指定等待者（超时路径），已被通知取走时返回 false
+        bool withdraw(const std::string& userId, const std::shared_ptr<Waiter>& waiter);
+
+        std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_ptr<Waiter>> waiters_;
+        std::shared_ptr<drogon::nosql::RedisSubscriber> subscriber_;
+        std::atomic<bool> active_{false};
+    };
+
+} // namespace lock
@@ -4,9 +4,32 @@
 #include "core/Constants.hpp"
 #include "core/Exception.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <random>
 
 namespace lock {
 
+namespace {
+
+    // 带抖动的指数退避：在 [d/2, d] 之间随机，d = min(cap, base * 2^attempt)
+    std::chrono::milliseconds jitteredBackoff(int attempt,
+                                              std::chrono::milliseconds base,
+                                              std::chrono::milliseconds cap) {
+        thread_local std::mt19937 gen{std::random_device{}()};
+
+        auto delay = base.count() << std::min(attempt, 16);
+        delay = std::max<int64_t>(1, std::min<int64_t>(delay, cap.count()));
+        std::uniform_int_distribution<int64_t> dist(delay / 2, delay);
+        return std::chrono::milliseconds(dist(gen));
+    }
+
+    trantor::EventLoop* currentLoop() {
+        auto* loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+        return loop ? loop : drogon::app().getLoop();
+    }
+
+} // namespace
+
 // ==================== UserLock ====================
 
 UserLock& UserLock::instance() {
@@ -14,8 +37,13 @@ UserLock& UserLock::instance() {
     return instance;
 }
 
+UserLock::UserLock() {
+    watchdog_.setLease(lockTimeout_);
+}
+
 void UserLock::setLockTimeout(std::chrono::seconds timeout) {
     lockTimeout_ = timeout;
+    watchdog_.setLease(timeout);
 }
 
 void UserLock::setRetryInterval(std::chrono::milliseconds interval) {
@@ -26,24 +54,34 @@ void UserLock::setMaxRetries(int retries) {
     maxRetries_ = retries;
 }
 
+void UserLock::setNotifyEnabled(bool enabled) {
+    notifyEnabled_ = enabled;
+}
+
 std::string UserLock::buildKey(const std::string& userId) const {
     return std::string(core::constants::REDIS_USER_LOCK_PREFIX) + userId;
 }
 
+void UserLock::start() {
+    if (notifyEnabled_) {
+        notifier_.start(core::constants::REDIS_USER_LOCK_RELEASED_CHANNEL);
+    }
+}
+
 std::string UserLock::generateLockValue() const {
-    return utils::Crypto::uuid();
+    return utils::Crypto::uuidV7();
 }
 
-drogon::Task<std::string> UserLock::tryLock(const std::string& userId) {
-    const auto key = buildKey(userId);
+drogon::Task<std::string> UserLock::acquireRemote(const std::string& key,
+                                                  const trace::SpanContext& parent) {
     const auto value = generateLockValue();
 
     try {
-        auto& redis = utils::Redis::instance();
-        bool acquired = co_await redis.lock(key, value, lockTimeout_);
+        bool acquired = co_await utils::Redis::instance().traced(parent).lock(key, value, lockTimeout_);
 
         if (acquired) {
-            spdlog::debug("User lock acquired: userId={}", userId);
+            spdlog::debug("User lock acquired: key={}", key);
+            watchdog_.add(key, value);
             co_return value;
         }
         co_return "";
@@ -53,68 +91,252 @@ drogon::Task<std::string> UserLock::tryLock(const std::string& userId) {
     }
 }
 
-drogon::Task<std::string> UserLock::lock(const std::string& userId) {
-    for (int i = 0; i < maxRetries_; ++i) {
-        auto lockValue = co_await tryLock(userId);
+drogon::Task<std::string> UserLock::tryLock(const std::string& userId) {
+    const auto key = buildKey(userId);
+
+    if (!localMutex_.tryLock(key)) {
+        co_return "";
+    }
+
+    auto lockValue = co_await acquireRemote(key, {});
+    if (lockValue.empty()) {
+        localMutex_.unlock(key);
+    }
+    co_return lockValue;
+}
+
+drogon::Task<std::string> UserLock::lock(const std::string& userId, trace::SpanContext parent) {
+    trace::Span span("user_lock.acquire", trace::SpanKind::Internal, parent);
+    const auto key = buildKey(userId);
+    const auto budget = retryInterval_ * maxRetries_;
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+
+    // 第一级：本地排队，同节点的竞争者在这里按 FIFO 移交，不访问 Redis
+    // 本地排队与 Redis 重试共用同一个截止时间，总等待不超过 budget
+    auto localTimeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    bool localAcquired = co_await localMutex_.lock(key, localTimeout);
+    if (!localAcquired) {
+        spdlog::warn("User lock local wait timeout: userId={}", userId);
+        co_return "";
+    }
+
+    // 第二级：只有本地持有者与其他节点竞争 Redis 锁
+    for (int attempt = 0; ; ++attempt) {
+        auto lockValue = co_await acquireRemote(key, span.context());
         if (!lockValue.empty()) {
             co_return lockValue;
         }
 
-        // 等待后重试（使用 Drogon 的协程睡眠）
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            break;
+        }
+
+        // 优先等待持有者释放时推送的唤醒令牌，失败时退化为退避轮询
+        if (co_await waitForRelease(userId, std::min(remaining, retryInterval_), span.context())) {
+            continue;
+        }
+
+        auto delay = std::min(remaining, jitteredBackoff(attempt, minBackoff_, retryInterval_));
         co_await drogon::sleepCoro(
-            drogon::app().getLoop(),
-            std::chrono::duration_cast<std::chrono::duration<double>>(retryInterval_)
+            currentLoop(),
+            std::chrono::duration_cast<std::chrono::duration<double>>(delay)
         );
     }
 
-    spdlog::warn("User lock timeout: userId={}, retries={}", userId, maxRetries_);
+    localMutex_.unlock(key);
+    span.setError();
+    spdlog::warn("User lock timeout: userId={}, waited={}ms", userId, budget.count());
     co_return "";
 }
 
+drogon::Task<bool> UserLock::waitForRelease(const std::string& userId,
+                                            std::chrono::milliseconds timeout,
+                                            const trace::SpanContext& parent) {
+    if (!notifyEnabled_ || !notifier_.active()) {
+        co_return false;
+    }
+
+    // 在订阅连接上等待释放消息，不占用共享命令连接；
+    // 加锁失败到登记等待之间发生的释放会被错过，最多多等一个 timeout（不超过 retryInterval）
+    trace::Span span("user_lock.wait_release", trace::SpanKind::Internal, parent);
+    const bool notified = co_await notifier_.wait(userId, timeout);
+    span.setAttribute("notified", notified ? "true" : "false");
+    co_return true;
+}
+
 drogon::Task<bool> UserLock::unlock(const std::string& userId, const std::string& lockValue) {
     if (lockValue.empty()) {
         co_return false;
     }
 
     const auto key = buildKey(userId);
+    bool released = false;
+
+    // 先停止续期，再释放
+    watchdog_.remove(key, lockValue);
 
     try {
         auto& redis = utils::Redis::instance();
-        bool released = co_await redis.unlock(key, lockValue);
+        if (notifyEnabled_) {
+            released = co_await redis.unlockAndNotify(
+                key, lockValue, core::constants::REDIS_USER_LOCK_RELEASED_CHANNEL, userId);
+        } else {
+            released = co_await redis.unlock(key, lockValue);
+        }
         if (released) {
             spdlog::debug("User lock released: userId={}", userId);
         }
-        co_return released;
     } catch (const core::RedisException& e) {
         spdlog::error("Failed to release user lock: {}", e.what());
+    }
+
+    // 无论 Redis 释放是否成功，本地锁都必须移交，否则同节点后续请求会一直排队
+    localMutex_.unlock(key);
+    co_return released;
+}
+
+drogon::Task<UserLockGuard> UserLock::lockMany(std::vector<std::string> userIds) {
+    // 固定顺序加锁，避免与其他批量 / 单个加锁者死锁
+    std::sort(userIds.begin(), userIds.end());
+    userIds.erase(std::unique(userIds.begin(), userIds.end()), userIds.end());
+
+    if (userIds.empty()) {
+        co_return UserLockGuard(std::move(userIds), "");
+    }
+    if (userIds.size() > utils::Redis::MAX_SCRIPT_KEYS) {
+        throw core::ParamException("too many users to lock at once");
+    }
+    if (userIds.size() == 1) {
+        auto lockValue = co_await lock(userIds.front());
+        co_return UserLockGuard(std::move(userIds), std::move(lockValue));
+    }
+
+    std::vector<std::string> keys;
+    keys.reserve(userIds.size());
+    for (const auto& userId : userIds) {
+        keys.push_back(buildKey(userId));
+    }
+
+    const auto budget = retryInterval_ * maxRetries_;
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+
+    // 第一级：按顺序获取本地锁
+    size_t localHeld = 0;
+    for (; localHeld < keys.size(); ++localHeld) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            break;
+        }
+        if (!co_await localMutex_.lock(keys[localHeld], remaining)) {
+            break;
+        }
+    }
+
+    if (localHeld == keys.size()) {
+        // 第二级：一次脚本原子获取全部 Redis 锁
+        const auto value = generateLockValue();
+        for (int attempt = 0; ; ++attempt) {
+            bool acquired = false;
+            try {
+                acquired = co_await utils::Redis::instance().lockMany(keys, value, lockTimeout_);
+            } catch (const core::RedisException& e) {
+                spdlog::error("Failed to acquire user locks: {}", e.what());
+            }
+
+            if (acquired) {
+                for (const auto& key : keys) {
+                    watchdog_.add(key, value);
+                }
+                spdlog::debug("User locks acquired: count={}", keys.size());
+                co_return UserLockGuard(std::move(userIds), value);
+            }
+
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                break;
+            }
+
+            // 多个 key 无法用单个通知列表等待，采用退避轮询
+            auto delay = std::min(remaining, jitteredBackoff(attempt, minBackoff_, retryInterval_));
+            co_await drogon::sleepCoro(
+                currentLoop(),
+                std::chrono::duration_cast<std::chrono::duration<double>>(delay)
+            );
+        }
+    }
+
+    for (size_t i = 0; i < localHeld; ++i) {
+        localMutex_.unlock(keys[i]);
+    }
+    spdlog::warn("User locks timeout: count={}, waited={}ms", keys.size(), budget.count());
+    co_return UserLockGuard(std::move(userIds), "");
+}
+
+drogon::Task<bool> UserLock::unlockMany(const std::vector<std::string>& userIds,
+                                        const std::string& lockValue) {
+    if (lockValue.empty() || userIds.empty()) {
         co_return false;
     }
+
+    std::vector<std::pair<std::string, std::string>> keys;
+    keys.reserve(userIds.size());
+    for (const auto& userId : userIds) {
+        keys.emplace_back(buildKey(userId), userId);
+        watchdog_.remove(keys.back().first, lockValue);
+    }
+
+    bool released = false;
+    try {
+        auto count = co_await utils::Redis::instance().unlockMany(
+            keys, lockValue, core::constants::REDIS_USER_LOCK_RELEASED_CHANNEL);
+        released = count == static_cast<int64_t>(keys.size());
+        spdlog::debug("User locks released: count={}/{}", count, keys.size());
+    } catch (const core::RedisException& e) {
+        spdlog::error("Failed to release user locks: {}", e.what());
+    }
+
+    for (const auto& entry : keys) {
+        localMutex_.unlock(entry.first);
+    }
+    co_return released;
 }
 
 // ==================== UserLockGuard ====================
 
 UserLockGuard::UserLockGuard(std::string userId, std::string lockValue)
-    : userId_(std::move(userId))
+    : userIds_{std::move(userId)}
+    , lockValue_(std::move(lockValue)) {
+}
+
+UserLockGuard::UserLockGuard(std::vector<std::string> userIds, std::string lockValue)
+    : userIds_(std::move(userIds))
     , lockValue_(std::move(lockValue)) {
 }
 
 UserLockGuard::~UserLockGuard() {
-    // 注意：析构函数中不能使用协程
-    // 如果需要在协程中自动释放，请手动调用 release()
+    // 析构函数中不能 co_await，未释放的锁（如协程因异常退出）转为后台异步释放
     if (!lockValue_.empty()) {
-        spdlog::warn("UserLockGuard destroyed without release, userId={}", userId_);
+        spdlog::debug("UserLockGuard destroyed without release, releasing in background: users={}",
+                      userIds_.size());
+        releaseDeferred();
     }
 }
 
 UserLockGuard::UserLockGuard(UserLockGuard&& other) noexcept
-    : userId_(std::move(other.userId_))
+    : userIds_(std::move(other.userIds_))
     , lockValue_(std::move(other.lockValue_)) {
     other.lockValue_.clear();
 }
 
 UserLockGuard& UserLockGuard::operator=(UserLockGuard&& other) noexcept {
     if (this != &other) {
-        userId_ = std::move(other.userId_);
+        releaseDeferred();
+        userIds_ = std::move(other.userIds_);
         lockValue_ = std::move(other.lockValue_);
         other.lockValue_.clear();
     }
@@ -122,10 +344,37 @@ UserLockGuard& UserLockGuard::operator=(UserLockGuard&& other) noexcept {
 }
 
 drogon::Task<void> UserLockGuard::release() {
-    if (!lockValue_.empty()) {
-        co_await UserLock::instance().unlock(userId_, lockValue_);
-        lockValue_.clear();
+    if (lockValue_.empty()) {
+        co_return;
+    }
+
+    if (userIds_.size() == 1) {
+        co_await UserLock::instance().unlock(userIds_.front(), lockValue_);
+    } else {
+        co_await UserLock::instance().unlockMany(userIds_, lockValue_);
+    }
+    lockValue_.clear();
+}
+
+void UserLockGuard::releaseDeferred() noexcept {
+    if (lockValue_.empty()) {
+        return;
+    }
+
+    try {
+        // 在当前循环上启动释放协程，调用方不等待 Redis 往返
+        drogon::async_run([userIds = userIds_, lockValue = std::move(lockValue_)]() -> drogon::Task<void> {
+            if (userIds.size() == 1) {
+                co_await UserLock::instance().unlock(userIds.front(), lockValue);
+            } else {
+                co_await UserLock::instance().unlockMany(userIds, lockValue);
+            }
+        });
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to schedule user lock release: users={}, error={}",
+                      userIds_.size(), e.what());
     }
+    lockValue_.clear();
 }
 
 } // namespace lock
\ No newline at end of file
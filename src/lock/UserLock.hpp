@@ -2,11 +2,21 @@
 
 #include <drogon/drogon.h>
 #include <string>
+#include <vector>
 #include <chrono>
+#include "KeyedMutex.hpp"
+#include "LeaseWatchdog.hpp"
+#include "ReleaseNotifier.hpp"
+#include "core/Constants.hpp"
+#include "trace/Span.hpp"
 
 namespace lock {
 
+    class UserLockGuard;
+
     // 用户锁管理器（协程版）
+    // 两级加锁：先进程内 KeyedMutex 排队，再由持有者去竞争 Redis 分布式锁
+    // Redis 锁使用短租约，持有期间由 LeaseWatchdog 自动续期，持有者崩溃后几秒内即可恢复
     class UserLock {
     public:
         // 单例获取
@@ -16,18 +26,31 @@ namespace lock {
         void setLockTimeout(std::chrono::seconds timeout);
         void setRetryInterval(std::chrono::milliseconds interval);
         void setMaxRetries(int retries);
+        // 释放时发布唤醒消息，等待方通过订阅接收（关闭则仅退避轮询）
+        void setNotifyEnabled(bool enabled);
+
+        // 订阅释放频道（需在 Redis 可用后调用；未启动时等待退化为退避轮询）
+        void start();
 
         // 尝试获取锁（协程，非阻塞）
         drogon::Task<std::string> tryLock(const std::string& userId);
 
-        // 获取锁（协程，阻塞带重试）
-        drogon::Task<std::string> lock(const std::string& userId);
+        // 获取锁（协程，阻塞带重试）；parent 有效时整个等待过程记录为子 Span
+        drogon::Task<std::string> lock(const std::string& userId, trace::SpanContext parent = {});
 
         // 释放锁（协程）
         drogon::Task<bool> unlock(const std::string& userId, const std::string& lockValue);
 
+        // 批量获取多个用户锁（协程）：排序去重后一次脚本原子获取，全有或全无
+        // 返回单个守卫，失败时 isLocked() 为 false
+        drogon::Task<UserLockGuard> lockMany(std::vector<std::string> userIds);
+
+        // 批量释放（协程，一次往返）
+        drogon::Task<bool> unlockMany(const std::vector<std::string>& userIds,
+                                      const std::string& lockValue);
+
     private:
-        UserLock() = default;
+        UserLock();
         ~UserLock() = default;
         UserLock(const UserLock&) = delete;
         UserLock& operator=(const UserLock&) = delete;
@@ -35,15 +58,29 @@ namespace lock {
         std::string buildKey(const std::string& userId) const;
         std::string generateLockValue() const;
 
-        std::chrono::seconds lockTimeout_{60};
+        // 竞争 Redis 锁（调用方需已持有本地锁）
+        drogon::Task<std::string> acquireRemote(const std::string& key, const trace::SpanContext& parent);
+
+        // 等待其他节点释放锁的通知；返回 false 表示需要退避轮询
+        drogon::Task<bool> waitForRelease(const std::string& userId,
+                                          std::chrono::milliseconds timeout,
+                                          const trace::SpanContext& parent);
+
+        KeyedMutex localMutex_;
+        LeaseWatchdog watchdog_;
+        ReleaseNotifier notifier_;
+        std::chrono::seconds lockTimeout_{core::constants::USER_LOCK_TIMEOUT};
         std::chrono::milliseconds retryInterval_{100};
         int maxRetries_{50};
+        std::chrono::milliseconds minBackoff_{5};
+        bool notifyEnabled_{true};
     };
 
-    // RAII 锁守卫（用于协程中自动释放）
+    // RAII 锁守卫（用于协程中自动释放，析构时未释放的锁会在后台异步释放）
     class UserLockGuard {
     public:
         UserLockGuard(std::string userId, std::string lockValue);
+        UserLockGuard(std::vector<std::string> userIds, std::string lockValue);
         ~UserLockGuard();
 
         // 禁止拷贝
@@ -60,8 +97,11 @@ namespace lock {
         // 手动释放（用于协程环境）
         drogon::Task<void> release();
 
+        // 延迟释放：不等待 Redis 往返，在当前循环上后台释放（先发响应再调用）
+        void releaseDeferred() noexcept;
+
     private:
-        std::string userId_;
+        std::vector<std::string> userIds_;
         std::string lockValue_;
     };
 
@@ -9,7 +9,16 @@
 #include "core/Exception.hpp"
 #include "core/Constants.hpp"
 #include "middleware/JwtFilter.hpp"
+#include "middleware/AccessLog.hpp"
+#include "metrics/HttpMetrics.hpp"
+#include "metrics/RuntimeMonitor.hpp"
+#include "trace/Tracer.hpp"
+#include "utils/PasswordHasher.hpp"
+#include "models/UserCountCache.hpp"
+#include "models/UserSearch.hpp"
 #include "queue/MessageQueue.hpp"
+#include "services/TokenRevocation.hpp"
+#include "lock/UserLock.hpp"
 
 // 初始化日志
 void initLogger() {
@@ -32,13 +41,12 @@ void initLogger() {
 
 // 初始化 JWT
 void initJwt(const Json::Value& config) {
-    auto secret = config.get("secret", core::constants::JWT_SECRET).asString();
-    auto issuer = config.get("issuer", core::constants::JWT_ISSUER).asString();
     auto expireHours = config.get("expire_hours", 24).asInt();
 
-    middleware::JwtUtil::setSecret(secret);
-    middleware::JwtUtil::setIssuer(issuer);
+    // 加载 jwt.secret（不带 kid 的旧 Token）以及 jwt.keys 中按 kid 区分的密钥
+    middleware::JwtUtil::loadKeys(config);
     middleware::JwtUtil::setExpireDuration(std::chrono::hours(expireHours));
+    middleware::JwtUtil::setCacheCapacity(config.get("cache_capacity", 65536).asUInt());
 }
 
 // 初始化消息队列（只注册处理器，不启动消费者）
@@ -115,6 +123,29 @@ Json::Value loadCustomConfig(const std::string& path) {
     return config;
 }
 
+// 定期检查配置文件中的 jwt 块，变更时热加载密钥（密钥轮换无需重启）
+void watchJwtKeys(const std::string& path, const Json::Value& initial) {
+    auto interval = initial.get("key_reload_seconds", 0).asDouble();
+    if (interval <= 0) {
+        return;
+    }
+
+    auto last = std::make_shared<Json::Value>(initial);
+    drogon::app().getLoop()->runEvery(interval, [path, last]() {
+        auto config = loadCustomConfig(path);
+        if (!config.isMember("jwt") || config["jwt"] == *last) {
+            return;
+        }
+
+        try {
+            middleware::JwtUtil::loadKeys(config["jwt"]);
+            *last = config["jwt"];
+        } catch (const std::exception& e) {
+            spdlog::error("Failed to reload JWT keys, keeping current keys: {}", e.what());
+        }
+    });
+}
+
 int main(int argc, char* argv[]) {
     // 创建日志目录
     std::filesystem::create_directories("logs");
@@ -135,6 +166,28 @@ int main(int argc, char* argv[]) {
             initJwt(customConfig["jwt"]);
         }
 
+        // 访问日志（后台线程批量写出）
+        auto& accessLog = middleware::AccessLog::instance();
+        accessLog.configure(customConfig.get("access_log", Json::Value()));
+        accessLog.start();
+
+        // 分布式追踪（W3C traceparent，后台线程批量导出）
+        auto& tracer = trace::Tracer::instance();
+        tracer.configure(customConfig.get("tracing", Json::Value()));
+        tracer.start();
+
+        // 密码哈希线程池（scrypt 计算不占用 IO 循环）
+        utils::PasswordHasher::instance().configure(customConfig.get("password_hash", Json::Value()));
+
+        // 用户列表总数缓存
+        models::UserCountCache::instance().configure(customConfig.get("user_count_cache", Json::Value()));
+
+        // 用户关键字搜索（ngram 全文索引）
+        models::UserSearch::instance().configure(customConfig.get("user_search", Json::Value()));
+
+        // 事件循环延迟监控（探测在服务启动后开始）
+        metrics::RuntimeMonitor::instance().configure(customConfig.get("runtime_monitor", Json::Value()));
+
         if (customConfig.isMember("queue")) {
             initMessageQueue(customConfig["queue"]);
         } else {
@@ -146,21 +199,42 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // 请求指标（处理前 / 处理后切面）
+    metrics::HttpMetrics::instance().install();
+    trace::Tracer::instance().install();
+
     // 设置异常处理
     setupExceptionHandler();
     setupNotFoundHandler();
 
     // 注册启动回调（此时 Redis 客户端已经初始化）
-    drogon::app().registerBeginningAdvice([]() {
+    drogon::app().registerBeginningAdvice([customConfig]() {
         spdlog::info("Server started");
 
+        if (customConfig.isMember("jwt")) {
+            watchJwtKeys("config.json", customConfig["jwt"]);
+        }
+
         // 在这里启动消费者，因为此时 Redis 已经可用
         queue::MessageQueue::instance().startConsumers("tasks");
         spdlog::info("Message queue consumers started");
+
+        // 加载 Token 吊销过滤器并订阅其他节点的吊销广播
+        services::TokenRevocation::instance().start();
+
+        // 订阅用户锁释放频道（等待方不再占用共享 Redis 连接）
+        lock::UserLock::instance().start();
+
+        // 此时所有 IO 循环均已运行
+        metrics::RuntimeMonitor::instance().start();
     });
 
     drogon::app().run();
 
+    // 写出剩余的访问日志与 Span
+    middleware::AccessLog::instance().stop();
+    trace::Tracer::instance().stop();
+
     // // 服务器停止后清理资源
     // spdlog::info("Server shutting down...");
     // queue::MessageQueue::instance().shutdown();
@@ -0,0 +1,184 @@
+#include "HttpMetrics.hpp"
+#include <drogon/drogon.h>
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+namespace metrics {
+
+namespace {
+
+    // 标记请求已计入处理中（过滤器拒绝、404 等不经过处理前切面，但仍会经过处理后切面）
+    const std::string IN_FLIGHT_ATTRIBUTE_KEY = "metricsInFlight";
+
+    // Prometheus 标签值转义
+    void appendLabelValue(std::string& out, std::string_view value) {
+        for (char c : value) {
+            switch (c) {
+                case '\\': out += "\\\\"; break;
+                case '"':  out += "\\\""; break;
+                case '\n': out += "\\n"; break;
+                default:   out += c;
+            }
+        }
+    }
+
+    void appendLabels(std::string& out, std::string_view method, std::string_view route, int status) {
+        out += "method=\"";
+        out += method;
+        out += "\",route=\"";
+        appendLabelValue(out, route);
+        out += "\",status=\"";
+        out += std::to_string(status);
+        out += '"';
+    }
+
+    std::string_view methodName(drogon::HttpMethod method) {
+        switch (method) {
+            case drogon::Get:     return "GET";
+            case drogon::Post:    return "POST";
+            case drogon::Head:    return "HEAD";
+            case drogon::Put:     return "PUT";
+            case drogon::Delete:  return "DELETE";
+            case drogon::Options: return "OPTIONS";
+            case drogon::Patch:   return "PATCH";
+            default:              return "INVALID";
+        }
+    }
+
+} // namespace
+
+void HttpMetrics::Histogram::merge(const Histogram& other) {
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    sumUs += other.sumUs;
+}
+
+HttpMetrics& HttpMetrics::instance() {
+    static HttpMetrics instance;
+    return instance;
+}
+
+void HttpMetrics::install() {
+    drogon::app().registerPreHandlingAdvice([this](const drogon::HttpRequestPtr& req) {
+        onRequestStart(req);
+    });
+    drogon::app().registerPostHandlingAdvice(
+        [this](const drogon::HttpRequestPtr& req, const drogon::HttpResponsePtr& resp) {
+            onRequestEnd(req, resp);
+        });
+}
+
+HttpMetrics::Shard& HttpMetrics::localShard() {
+    thread_local Shard* shard = nullptr;
+    if (!shard) {
+        auto owned = std::make_shared<Shard>();
+        shard = owned.get();
+        std::lock_guard<std::mutex> lk(shardsMutex_);
+        shards_.push_back(std::move(owned));
+    }
+    return *shard;
+}
+
+void HttpMetrics::onRequestStart(const drogon::HttpRequestPtr& req) {
+    req->getAttributes()->insert(IN_FLIGHT_ATTRIBUTE_KEY, true);
+    localShard().inFlight.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HttpMetrics::onRequestEnd(const drogon::HttpRequestPtr& req, const drogon::HttpResponsePtr& resp) {
+    // 从请求解析完成开始计时（包含过滤器耗时）
+    const int64_t elapsedUs = trantor::Date::now().microSecondsSinceEpoch() -
+                              req->creationDate().microSecondsSinceEpoch();
+    const double seconds = static_cast<double>(elapsedUs) / 1e6;
+    const size_t bucket = static_cast<size_t>(
+        std::lower_bound(BUCKETS.begin(), BUCKETS.end(), seconds) - BUCKETS.begin());
+
+    const auto method = req->method();
+    const int status = static_cast<int>(resp->statusCode());
+    const std::string_view route = req->getMatchedPathPattern();
+
+    auto& shard = localShard();
+    // 只回减处理前计入过的请求；处理前 / 处理后可能落在不同线程，只汇总总和
+    if (req->getAttributes()->find(IN_FLIGHT_ATTRIBUTE_KEY)) {
+        req->getAttributes()->erase(IN_FLIGHT_ATTRIBUTE_KEY);
+        shard.inFlight.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lk(shard.mutex);
+    auto it = shard.routes.find(route);
+    if (it == shard.routes.end()) {
+        it = shard.routes.emplace(std::string(route), std::vector<Series>{}).first;
+    }
+
+    auto& series = it->second;
+    auto s = std::find_if(series.begin(), series.end(), [&](const Series& item) {
+        return item.method == method && item.status == status;
+    });
+    if (s == series.end()) {
+        series.push_back(Series{method, status, {}});
+        s = std::prev(series.end());
+    }
+
+    ++s->histogram.buckets[bucket];
+    ++s->histogram.count;
+    s->histogram.sumUs += elapsedUs;
+}
+
+void HttpMetrics::render(std::string& out) {
+    std::vector<std::shared_ptr<Shard>> shards;
+    {
+        std::lock_guard<std::mutex> lk(shardsMutex_);
+        shards = shards_;
+    }
+
+    // 汇总所有分片（按标签排序，输出稳定）
+    std::map<std::tuple<std::string, std::string_view, int>, Histogram> merged;
+    int64_t inFlight = 0;
+    for (const auto& shard : shards) {
+        inFlight += shard->inFlight.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lk(shard->mutex);
+        for (const auto& [route, series] : shard->routes) {
+            for (const auto& s : series) {
+                merged[{route, methodName(s.method), s.status}].merge(s.histogram);
+            }
+        }
+    }
+
+    out += "# HELP http_request_duration_seconds HTTP request latency by method, route and status.\n";
+    out += "# TYPE http_request_duration_seconds histogram\n";
+    for (const auto& [key, histogram] : merged) {
+        const auto& [route, method, status] = key;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < histogram.buckets.size(); ++i) {
+            cumulative += histogram.buckets[i];
+            out += "http_request_duration_seconds_bucket{";
+            appendLabels(out, method, route, status);
+            out += ",le=\"";
+            out += i < BUCKETS.size() ? fmt::format("{}", BUCKETS[i]) : "+Inf";
+            out += "\"} ";
+            out += std::to_string(cumulative);
+            out += '\n';
+        }
+        out += "http_request_duration_seconds_sum{";
+        appendLabels(out, method, route, status);
+        out += "} ";
+        out += fmt::format("{}", static_cast<double>(histogram.sumUs) / 1e6);
+        out += '\n';
+        out += "http_request_duration_seconds_count{";
+        appendLabels(out, method, route, status);
+        out += "} ";
+        out += std::to_string(histogram.count);
+        out += '\n';
+    }
+
+    out += "# HELP http_requests_in_flight HTTP requests currently being handled.\n";
+    out += "# TYPE http_requests_in_flight gauge\n";
+    out += "http_requests_in_flight ";
+    out += std::to_string(inFlight);
+    out += '\n';
+}
+
+} // namespace metrics
\ No newline at end of file
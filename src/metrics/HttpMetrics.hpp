@@ -0,0 +1,71 @@
+#pragma once
+
+#include <drogon/HttpRequest.h>
+#include <drogon/HttpResponse.h>
+#include "utils/FastPath.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace metrics {
+
+    // HTTP 请求指标：按 {method, route, status} 的延迟直方图 + 处理中请求数
+    // 每个线程写入自己的分片（无跨线程竞争），抓取时再汇总
+    class HttpMetrics {
+    public:
+        // 直方图桶上界（秒），最后隐含 +Inf
+        static constexpr std::array<double, 13> BUCKETS = {
+            0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+
+        // 单例获取
+        static HttpMetrics& instance();
+
+        // 注册处理前 / 处理后切面（需在 app().run() 之前调用）
+        void install();
+
+        // 请求开始 / 完成（由切面调用）；只有开始时被标记的请求在完成时回减处理中计数
+        void onRequestStart(const drogon::HttpRequestPtr& req);
+        void onRequestEnd(const drogon::HttpRequestPtr& req, const drogon::HttpResponsePtr& resp);
+
+        // 以 Prometheus 文本格式输出
+        void render(std::string& out);
+
+    private:
+        struct Histogram {
+            std::array<uint64_t, BUCKETS.size() + 1> buckets{};
+            uint64_t count{0};
+            int64_t sumUs{0};
+
+            void merge(const Histogram& other);
+        };
+
+        struct Series {
+            drogon::HttpMethod method;
+            int status;
+            Histogram histogram;
+        };
+
+        // 单线程分片：写入方只有所属线程，mutex 仅在抓取时产生竞争
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<std::string, std::vector<Series>, utils::TransparentStringHash, std::equal_to<>> routes;
+            std::atomic<int64_t> inFlight{0};
+        };
+
+        HttpMetrics() = default;
+        HttpMetrics(const HttpMetrics&) = delete;
+        HttpMetrics& operator=(const HttpMetrics&) = delete;
+
+        Shard& localShard();
+
+        std::mutex shardsMutex_;
+        std::vector<std::shared_ptr<Shard>> shards_;
+    };
+
+} // namespace metrics
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "RuntimeMonitor.hpp"
+#include "queue/MessageQueue.hpp"
+#include <drogon/drogon.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace metrics {
+
+namespace {
+
+    // 同一循环的延迟告警至多每秒一条，避免阻塞期间刷屏
+    constexpr auto WARN_INTERVAL = std::chrono::seconds(1);
+
+    std::string secondsString(int64_t us) {
+        return fmt::format("{}", static_cast<double>(us) / 1e6);
+    }
+
+} // namespace
+
+RuntimeMonitor& RuntimeMonitor::instance() {
+    static RuntimeMonitor instance;
+    return instance;
+}
+
+void RuntimeMonitor::configure(const Json::Value& config) {
+    enabled_ = config.get("enabled", true).asBool();
+    interval_ = std::chrono::milliseconds(
+        std::max(10, config.get("interval_ms", 100).asInt()));
+    warnThreshold_ = std::chrono::milliseconds(
+        std::max(1, config.get("lag_warn_ms", 50).asInt()));
+}
+
+void RuntimeMonitor::start() {
+    if (!enabled_ || started_.exchange(true)) {
+        return;
+    }
+
+    auto addProbe = [this](std::string name, trantor::EventLoop* loop) {
+        auto probe = std::make_unique<LoopProbe>();
+        probe->name = std::move(name);
+        probe->loop = loop;
+        probes_.push_back(std::move(probe));
+    };
+
+    addProbe("main", drogon::app().getLoop());
+    for (size_t i = 0; i < drogon::app().getThreadNum(); ++i) {
+        addProbe(fmt::format("io-{}", i), drogon::app().getIOLoop(i));
+    }
+
+    for (const auto& probe : probes_) {
+        schedule(probe.get());
+    }
+    // probes_ 此后不再变化，render 可无锁遍历
+    ready_.store(true, std::memory_order_release);
+
+    spdlog::info("Runtime monitor started: loops={}, interval={}ms, warn={}ms",
+                 probes_.size(), interval_.count(), warnThreshold_.count());
+}
+
+void RuntimeMonitor::schedule(LoopProbe* probe) {
+    const auto expected = std::chrono::steady_clock::now() + interval_;
+    const double delay = std::chrono::duration<double>(interval_).count();
+    probe->loop->runAfter(delay, [this, probe, expected]() {
+        onTick(*probe, expected);
+        schedule(probe);
+    });
+}
+
+void RuntimeMonitor::onTick(LoopProbe& probe, std::chrono::steady_clock::time_point expected) {
+    const auto now = std::chrono::steady_clock::now();
+    const int64_t lagUs = std::max<int64_t>(
+        0, std::chrono::duration_cast<std::chrono::microseconds>(now - expected).count());
+
+    probe.lastLagUs.store(lagUs, std::memory_order_relaxed);
+    auto max = probe.maxLagUs.load(std::memory_order_relaxed);
+    while (lagUs > max &&
+           !probe.maxLagUs.compare_exchange_weak(max, lagUs, std::memory_order_relaxed)) {
+    }
+
+    if (lagUs < std::chrono::duration_cast<std::chrono::microseconds>(warnThreshold_).count()) {
+        return;
+    }
+
+    probe.slowTicks.fetch_add(1, std::memory_order_relaxed);
+    if (now - probe.lastWarn >= WARN_INTERVAL) {
+        probe.lastWarn = now;
+        spdlog::warn("Event loop lag: loop={}, lag={}ms, threshold={}ms",
+                     probe.name, lagUs / 1000, warnThreshold_.count());
+    }
+}
+
+void RuntimeMonitor::render(std::string& out) {
+    if (!ready_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    out += "# HELP event_loop_lag_seconds Timer scheduling delay observed at the latest tick.\n";
+    out += "# TYPE event_loop_lag_seconds gauge\n";
+    for (const auto& probe : probes_) {
+        out += fmt::format("event_loop_lag_seconds{{loop=\"{}\"}} {}\n",
+                           probe->name, secondsString(probe->lastLagUs.load(std::memory_order_relaxed)));
+    }
+
+    // 最大值在抓取时清零，反映两次抓取之间的最坏情况
+    out += "# HELP event_loop_lag_max_seconds Maximum timer scheduling delay since the previous scrape.\n";
+    out += "# TYPE event_loop_lag_max_seconds gauge\n";
+    for (const auto& probe : probes_) {
+        out += fmt::format("event_loop_lag_max_seconds{{loop=\"{}\"}} {}\n",
+                           probe->name, secondsString(probe->maxLagUs.exchange(0, std::memory_order_relaxed)));
+    }
+
+    out += "# HELP event_loop_slow_ticks_total Ticks whose delay exceeded the warning threshold.\n";
+    out += "# TYPE event_loop_slow_ticks_total counter\n";
+    for (const auto& probe : probes_) {
+        out += fmt::format("event_loop_slow_ticks_total{{loop=\"{}\"}} {}\n",
+                           probe->name, probe->slowTicks.load(std::memory_order_relaxed));
+    }
+
+    auto& queue = queue::MessageQueue::instance();
+    out += "# HELP queue_consumers_running Message queue consumer coroutines currently running.\n";
+    out += "# TYPE queue_consumers_running gauge\n";
+    out += fmt::format("queue_consumers_running {}\n", queue.runningConsumers());
+    out += "# HELP queue_messages_in_flight Messages currently being handled by consumers.\n";
+    out += "# TYPE queue_messages_in_flight gauge\n";
+    out += fmt::format("queue_messages_in_flight {}\n", queue.inFlightMessages());
+}
+
+} // namespace metrics
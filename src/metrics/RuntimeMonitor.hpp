@@ -0,0 +1,58 @@
+#pragma once
+
+#include <json/json.h>
+#include <trantor/net/EventLoop.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace metrics {
+
+    // 运行时监控：事件循环调度延迟 + 处理中的请求 / 队列消费协程
+    // 每个循环上挂一个周期定时器，记录实际触发时间比预期晚了多少；
+    // IO 线程上的阻塞操作（密码哈希、同步日志、大 JSON 构建）会直接体现为延迟
+    class RuntimeMonitor {
+    public:
+        // 单例获取
+        static RuntimeMonitor& instance();
+
+        // 读取 runtime_monitor 配置
+        void configure(const Json::Value& config);
+
+        // 在所有 IO 循环与主循环上启动探测（需在 app().run() 之后，即 BeginningAdvice 中调用）
+        void start();
+
+        // 以 Prometheus 文本格式输出
+        void render(std::string& out);
+
+    private:
+        // 单个循环的探测状态（只由所属循环写入）
+        struct LoopProbe {
+            std::string name;
+            trantor::EventLoop* loop{nullptr};
+            std::atomic<int64_t> lastLagUs{0};
+            std::atomic<int64_t> maxLagUs{0};      // 上次抓取以来的最大值
+            std::atomic<uint64_t> slowTicks{0};    // 超过告警阈值的次数
+            std::chrono::steady_clock::time_point lastWarn{};
+        };
+
+        RuntimeMonitor() = default;
+        RuntimeMonitor(const RuntimeMonitor&) = delete;
+        RuntimeMonitor& operator=(const RuntimeMonitor&) = delete;
+
+        void schedule(LoopProbe* probe);
+        void onTick(LoopProbe& probe, std::chrono::steady_clock::time_point expected);
+
+        bool enabled_{true};
+        std::chrono::milliseconds interval_{100};
+        std::chrono::milliseconds warnThreshold_{50};
+
+        std::atomic<bool> started_{false};
+        std::atomic<bool> ready_{false};
+        std::vector<std::unique_ptr<LoopProbe>> probes_;
+    };
+
+} // namespace metrics
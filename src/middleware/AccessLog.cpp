@@ -0,0 +1,149 @@
+#include "AccessLog.hpp"
+#include "utils/FastPath.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+
+namespace middleware {
+
+namespace {
+
+    // 单批最多写出条数（避免单次排空占用过久）
+    constexpr size_t MAX_BATCH = 4096;
+
+    // 令牌桶（容量等于每秒速率）
+    struct Bucket {
+        double tokens{0};
+        std::chrono::steady_clock::time_point last;
+    };
+
+} // namespace
+
+AccessLog& AccessLog::instance() {
+    static AccessLog instance;
+    return instance;
+}
+
+AccessLog::~AccessLog() {
+    stop();
+}
+
+void AccessLog::configure(const Json::Value& config) {
+    enabled_ = config.get("enabled", true).asBool();
+    logBody_ = config.get("log_body", false).asBool();
+    sampleRate_ = std::clamp(config.get("sample_rate", 1.0).asDouble(), 0.0, 1.0);
+    routeRateLimit_ = std::max(0.0, config.get("route_rate_limit", 0).asDouble());
+    ringCapacity_ = std::max<size_t>(64, config.get("ring_capacity", 8192).asUInt());
+    flushInterval_ = std::chrono::milliseconds(
+        std::max(1, config.get("flush_interval_ms", 50).asInt()));
+}
+
+void AccessLog::start() {
+    if (!enabled_ || writer_.joinable()) {
+        return;
+    }
+    writer_ = std::jthread([this](std::stop_token stop) {
+        run(stop);
+    });
+    spdlog::info("Access log started: sampleRate={}, routeRateLimit={}, ringCapacity={}",
+                 sampleRate_, routeRateLimit_, ringCapacity_);
+}
+
+void AccessLog::stop() {
+    if (!writer_.joinable()) {
+        return;
+    }
+    writer_.request_stop();
+    writer_.join();
+}
+
+bool AccessLog::admit(std::string_view route) {
+    if (sampleRate_ < 1.0 && utils::fastSample() >= sampleRate_) {
+        return false;
+    }
+    if (routeRateLimit_ <= 0) {
+        return true;
+    }
+
+    thread_local std::unordered_map<std::string, Bucket, utils::TransparentStringHash, std::equal_to<>> buckets;
+    auto now = std::chrono::steady_clock::now();
+    auto it = buckets.find(route);
+    if (it == buckets.end()) {
+        it = buckets.emplace(std::string(route), Bucket{routeRateLimit_, now}).first;
+    }
+
+    auto& bucket = it->second;
+    std::chrono::duration<double> elapsed = now - bucket.last;
+    bucket.last = now;
+    bucket.tokens = std::min(routeRateLimit_, bucket.tokens + elapsed.count() * routeRateLimit_);
+    if (bucket.tokens < 1.0) {
+        return false;
+    }
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+void AccessLog::submit(const AccessRecord& record) {
+    if (!localRing().tryPush(record)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+AccessLog::Ring& AccessLog::localRing() {
+    thread_local Ring* ring = nullptr;
+    if (!ring) {
+        auto owned = std::make_shared<Ring>(ringCapacity_);
+        ring = owned.get();
+        std::lock_guard<std::mutex> lk(ringsMutex_);
+        rings_.push_back(std::move(owned));
+    }
+    return *ring;
+}
+
+void AccessLog::run(std::stop_token stop) {
+    while (!stop.stop_requested()) {
+        if (drain() < MAX_BATCH) {
+            std::this_thread::sleep_for(flushInterval_);
+        }
+    }
+    // 退出前写出剩余记录
+    while (drain() > 0) {
+    }
+}
+
+size_t AccessLog::drain() {
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lk(ringsMutex_);
+        rings = rings_;
+    }
+
+    auto logger = spdlog::default_logger();
+    size_t written = 0;
+    AccessRecord record;
+    fmt::memory_buffer line;
+    for (const auto& ring : rings) {
+        while (written < MAX_BATCH && ring->tryPop(record)) {
+            // 保留请求到达时间作为日志时间
+            line.clear();
+            fmt::format_to(std::back_inserter(line), "[{}] --> {} {} from {}",
+                           record.requestId, record.method, record.path, record.clientIp);
+            logger->log(record.time, spdlog::source_loc{}, spdlog::level::info,
+                        spdlog::string_view_t(line.data(), line.size()));
+            ++written;
+        }
+    }
+
+    auto dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reportedDropped_) {
+        spdlog::warn("Access log dropped {} records (total {})", dropped - reportedDropped_, dropped);
+        reportedDropped_ = dropped;
+    }
+    return written;
+}
+
+} // namespace middleware
\ No newline at end of file
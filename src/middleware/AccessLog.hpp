@@ -0,0 +1,82 @@
+#pragma once
+
+#include <json/json.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "utils/SpscRing.hpp"
+
+namespace middleware {
+
+    // 访问日志记录（定长，写入环形缓冲区时无需分配；超长字段截断）
+    struct AccessRecord {
+        std::chrono::system_clock::time_point time;
+        char requestId[40]{};
+        char method[8]{};
+        char clientIp[48]{};
+        char path[192]{};
+    };
+
+    // 异步批量访问日志
+    // IO 线程只把定长记录写入本线程的无锁环形缓冲区，格式化与写出由后台线程批量完成
+    // 缓冲区满时直接丢弃并计数，从不阻塞请求
+    class AccessLog {
+    public:
+        // 单例获取
+        static AccessLog& instance();
+
+        // 从 access_log 配置块加载（需在 start 之前调用）
+        void configure(const Json::Value& config);
+
+        // 启动 / 停止后台写出线程（停止时写出剩余记录）
+        void start();
+        void stop();
+
+        [[nodiscard]] bool enabled() const noexcept { return enabled_; }
+        [[nodiscard]] bool logBody() const noexcept { return logBody_; }
+
+        // 采样与按路由限流（每个 IO 线程独立计数，无共享状态）；false 表示本条不记录
+        bool admit(std::string_view route);
+
+        // 提交记录（非阻塞）
+        void submit(const AccessRecord& record);
+
+        // 因缓冲区满而丢弃的记录数
+        [[nodiscard]] uint64_t dropped() const noexcept {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        using Ring = utils::SpscRing<AccessRecord>;
+
+        AccessLog() = default;
+        ~AccessLog();
+        AccessLog(const AccessLog&) = delete;
+        AccessLog& operator=(const AccessLog&) = delete;
+
+        // 当前线程的环形缓冲区（首次使用时注册）
+        Ring& localRing();
+
+        // 后台线程：周期性排空所有缓冲区
+        void run(std::stop_token stop);
+        size_t drain();
+
+        bool enabled_{true};
+        bool logBody_{false};
+        double sampleRate_{1.0};
+        double routeRateLimit_{0};  // 每个路由每个 IO 线程每秒最多记录条数，0 表示不限
+        size_t ringCapacity_{8192};
+        std::chrono::milliseconds flushInterval_{50};
+
+        std::mutex ringsMutex_;
+        std::vector<std::shared_ptr<Ring>> rings_;
+        std::atomic<uint64_t> dropped_{0};
+        uint64_t reportedDropped_{0};  // 仅后台线程访问
+        std::jthread writer_;
+    };
+
+} // namespace middleware
\ No newline at end of file
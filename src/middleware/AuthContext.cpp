@@ -0,0 +1,62 @@
+#include "AuthContext.hpp"
+#include "JwtFilter.hpp"
+#include "core/Exception.hpp"
+#include <charconv>
+
+namespace middleware {
+
+namespace {
+
+    const std::string ATTRIBUTE_KEY = "authContext";
+
+} // namespace
+
+Role parseRole(std::string_view role) noexcept {
+    if (role == "user") {
+        return Role::User;
+    }
+    if (role == "admin") {
+        return Role::Admin;
+    }
+    return Role::Unknown;
+}
+
+std::string_view roleName(Role role) noexcept {
+    switch (role) {
+        case Role::User:  return "user";
+        case Role::Admin: return "admin";
+        default:          return "unknown";
+    }
+}
+
+std::shared_ptr<const AuthContext> AuthContext::fromPayload(const JwtPayload& payload) {
+    int64_t userId = 0;
+    const auto* first = payload.userId.data();
+    const auto* last = first + payload.userId.size();
+    auto [ptr, ec] = std::from_chars(first, last, userId);
+    if (ec != std::errc() || ptr != last) {
+        return nullptr;
+    }
+
+    auto ctx = std::make_shared<AuthContext>();
+    ctx->userId = userId;
+    ctx->username = payload.username;
+    ctx->role = parseRole(payload.role);
+    ctx->exp = payload.exp;
+    ctx->tokenId = payload.tokenId;
+    return ctx;
+}
+
+const AuthContext& AuthContext::from(const drogon::HttpRequestPtr& req) {
+    const auto& ctx = req->getAttributes()->get<std::shared_ptr<const AuthContext>>(ATTRIBUTE_KEY);
+    if (!ctx) {
+        throw core::AuthException(core::ErrorCode::TOKEN_MISSING);
+    }
+    return *ctx;
+}
+
+void AuthContext::attach(const drogon::HttpRequestPtr& req, std::shared_ptr<const AuthContext> ctx) {
+    req->getAttributes()->insert(ATTRIBUTE_KEY, std::move(ctx));
+}
+
+} // namespace middleware
\ No newline at end of file
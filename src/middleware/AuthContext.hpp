@@ -0,0 +1,41 @@
+#pragma once
+
+#include <drogon/HttpRequest.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace middleware {
+
+    struct JwtPayload;
+
+    // 用户角色（Token 中的 role 声明在验证时解析一次）
+    enum class Role : uint8_t {
+        User,
+        Admin,
+        Unknown,
+    };
+
+    Role parseRole(std::string_view role) noexcept;
+    std::string_view roleName(Role role) noexcept;
+
+    // 已认证请求的上下文（不可变，随 Token 缓存复用，同一 Token 的请求共享同一对象）
+    struct AuthContext {
+        int64_t userId{0};
+        std::string username;
+        Role role{Role::Unknown};
+        int64_t exp{0};       // 过期时间（与 JwtPayload::exp 同单位）
+        std::string tokenId;  // 吊销标识
+
+        // 由已验证的载荷构建；userId 非法时返回 nullptr
+        static std::shared_ptr<const AuthContext> fromPayload(const JwtPayload& payload);
+
+        // 从请求属性读取（由 JwtFilter 写入）；缺失时抛出 AuthException
+        static const AuthContext& from(const drogon::HttpRequestPtr& req);
+
+        // 写入请求属性
+        static void attach(const drogon::HttpRequestPtr& req, std::shared_ptr<const AuthContext> ctx);
+    };
+
+} // namespace middleware
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "AuthzFilter.hpp"
+#include "core/Response.hpp"
+#include "core/Exception.hpp"
+#include "utils/FastPath.hpp"
+#include <spdlog/spdlog.h>
+#include <array>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace middleware {
+
+namespace {
+
+    constexpr PermissionSet USER_PERMISSIONS =
+        PERM_SESSION_SELF | PERM_USER_READ_SELF | PERM_USER_UPDATE_SELF;
+
+    constexpr PermissionSet ADMIN_PERMISSIONS =
+        USER_PERMISSIONS | PERM_USER_READ_ANY | PERM_USER_LIST | PERM_USER_UPDATE_ANY |
+        PERM_USER_ASSIGN_ROLE | PERM_USER_SET_STATUS | PERM_USER_DELETE;
+
+    // 按 Role 枚举值索引
+    constexpr std::array<PermissionSet, 3> ROLE_PERMISSIONS = {
+        USER_PERMISSIONS,   // Role::User
+        ADMIN_PERMISSIONS,  // Role::Admin
+        PERM_NONE,          // Role::Unknown
+    };
+
+    // 路由规则声明
+    struct RouteRule {
+        drogon::HttpMethod method;
+        const char* pattern;
+        PermissionSet self;  // 目标为当前用户（或路由不含 {id}）时所需权限
+        PermissionSet any;   // 目标为其他用户时所需权限
+    };
+
+    constexpr RouteRule ROUTE_RULES[] = {
+        {drogon::Post,   "/api/auth/logout",       PERM_SESSION_SELF,    PERM_SESSION_SELF},
+        {drogon::Post,   "/api/auth/refresh",      PERM_SESSION_SELF,    PERM_SESSION_SELF},
+        {drogon::Put,    "/api/auth/password",     PERM_SESSION_SELF,    PERM_SESSION_SELF},
+        {drogon::Get,    "/api/user/me",           PERM_USER_READ_SELF,  PERM_USER_READ_SELF},
+        {drogon::Get,    "/api/user/list",         PERM_USER_LIST,       PERM_USER_LIST},
+        {drogon::Get,    "/api/user/{id}",         PERM_USER_READ_SELF,  PERM_USER_READ_ANY},
+        {drogon::Put,    "/api/user/{id}",         PERM_USER_UPDATE_SELF, PERM_USER_UPDATE_ANY},
+        {drogon::Put,    "/api/user/{id}/status",  PERM_USER_SET_STATUS, PERM_USER_SET_STATUS},
+        {drogon::Delete, "/api/user/{id}",         PERM_USER_DELETE,     PERM_USER_DELETE},
+    };
+
+    // 编译后的规则：{id} 所在的路径段下标（-1 表示不含）
+    struct CompiledRule {
+        PermissionSet self;
+        PermissionSet any;
+        int idSegment;
+    };
+
+    using RuleMap = std::unordered_map<std::string, CompiledRule, utils::TransparentStringHash, std::equal_to<>>;
+    using RuleTable = std::array<RuleMap, drogon::Invalid>;
+
+    int findIdSegment(std::string_view pattern) {
+        int segment = -1;
+        for (size_t pos = 0; pos < pattern.size(); ++pos) {
+            if (pattern[pos] != '/') {
+                continue;
+            }
+            ++segment;
+            if (pattern.substr(pos + 1, 4) == "{id}") {
+                return segment;
+            }
+        }
+        return -1;
+    }
+
+    const RuleTable& ruleTable() {
+        static const RuleTable table = [] {
+            RuleTable t;
+            for (const auto& rule : ROUTE_RULES) {
+                t[rule.method].emplace(rule.pattern,
+                                       CompiledRule{rule.self, rule.any, findIdSegment(rule.pattern)});
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    // 取路径中第 index 段（以 '/' 分隔，首段下标为 0）
+    std::string_view pathSegment(std::string_view path, int index) {
+        size_t pos = 0;
+        for (int i = 0; i <= index; ++i) {
+            pos = path.find('/', pos);
+            if (pos == std::string_view::npos) {
+                return {};
+            }
+            ++pos;
+        }
+        auto end = path.find('/', pos);
+        return path.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos);
+    }
+
+    bool targetsSelf(std::string_view segment, int64_t userId) {
+        int64_t target = 0;
+        auto [ptr, ec] = std::from_chars(segment.data(), segment.data() + segment.size(), target);
+        return ec == std::errc() && ptr == segment.data() + segment.size() && target == userId;
+    }
+
+} // namespace
+
+PermissionSet permissionsOf(Role role) noexcept {
+    auto index = static_cast<size_t>(role);
+    return index < ROLE_PERMISSIONS.size() ? ROLE_PERMISSIONS[index] : PERM_NONE;
+}
+
+AuthzFilter::AuthzFilter() {
+    // 启动时构建规则表
+    ruleTable();
+}
+
+void AuthzFilter::doFilter(const drogon::HttpRequestPtr& req,
+                           drogon::FilterCallback&& fcb,
+                           drogon::FilterChainCallback&& fccb) {
+    const AuthContext* ctx = nullptr;
+    try {
+        ctx = &AuthContext::from(req);
+    } catch (const core::AuthException& e) {
+        fcb(core::Response::fromException(e));
+        return;
+    }
+
+    const auto method = req->method();
+    const auto& rules = ruleTable();
+    if (method >= drogon::Invalid) {
+        fcb(core::Response::error(core::ErrorCode::PERMISSION_DENIED));
+        return;
+    }
+
+    const auto& byPattern = rules[method];
+    auto it = byPattern.find(std::string_view(req->getMatchedPathPattern()));
+    if (it == byPattern.end()) {
+        spdlog::warn("Authz rule missing for route: {} {}",
+                     req->getMethodString(), req->getMatchedPathPattern());
+        fcb(core::Response::error(core::ErrorCode::PERMISSION_DENIED));
+        return;
+    }
+
+    const auto& rule = it->second;
+    PermissionSet required = rule.self;
+    if (rule.idSegment >= 0 &&
+        !targetsSelf(pathSegment(req->path(), rule.idSegment), ctx->userId)) {
+        required = rule.any;
+    }
+
+    if (!hasPermission(ctx->role, required)) {
+        spdlog::debug("Authz denied: userId={}, role={}, path={}",
+                      ctx->userId, roleName(ctx->role), req->path());
+        fcb(core::Response::error(core::ErrorCode::PERMISSION_DENIED));
+        return;
+    }
+
+    fccb();
+}
+
+} // namespace middleware
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <drogon/HttpFilter.h>
+#include <cstdint>
+#include "AuthContext.hpp"
+
+namespace middleware {
+
+    // 权限位（每个角色对应一个位集合）
+    enum Permission : uint32_t {
+        PERM_NONE             = 0,
+        PERM_SESSION_SELF     = 1u << 0,  // 登出 / 刷新 / 修改自己的密码
+        PERM_USER_READ_SELF   = 1u << 1,
+        PERM_USER_READ_ANY    = 1u << 2,
+        PERM_USER_LIST        = 1u << 3,
+        PERM_USER_UPDATE_SELF = 1u << 4,
+        PERM_USER_UPDATE_ANY  = 1u << 5,
+        PERM_USER_ASSIGN_ROLE = 1u << 6,
+        PERM_USER_SET_STATUS  = 1u << 7,
+        PERM_USER_DELETE      = 1u << 8,
+    };
+
+    using PermissionSet = uint32_t;
+
+    // 角色对应的权限集合
+    PermissionSet permissionsOf(Role role) noexcept;
+
+    inline bool hasPermission(Role role, PermissionSet required) noexcept {
+        return (permissionsOf(role) & required) == required;
+    }
+
+    // 基于角色的授权过滤器（需放在 JwtFilter 之后）
+    // 路由（方法 + 匹配的路径模式）到所需权限的映射在启动时构建，检查只需一次位与运算
+    // 含 {id} 的路由按目标是否为当前用户区分 self / any 权限；未登记的路由一律拒绝
+    class AuthzFilter : public drogon::HttpFilter<AuthzFilter> {
+    public:
+        AuthzFilter();
+
+        void doFilter(const drogon::HttpRequestPtr& req,
+                      drogon::FilterCallback&& fcb,
+                      drogon::FilterChainCallback&& fccb) override;
+    };
+
+} // namespace middleware
\ No newline at end of file
@@ -0,0 +1,354 @@
+#include "JwtFastPath.hpp"
+#include "utils/Crypto.hpp"
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <memory>
+#include <string>
+
+namespace middleware::jwtfast {
+
+namespace {
+
+    // 扁平 JSON 对象扫描器：只接受字符串 / 整数 / 布尔 / null 值
+    class FlatObjectScanner {
+    public:
+        explicit FlatObjectScanner(std::string_view json) : json_(json) {}
+
+        struct Value {
+            enum class Type { String, Integer, Literal } type;
+            std::string_view str;
+            int64_t integer{0};
+        };
+
+        // 读取下一个键值对；结束时 done 置为 true
+        bool next(std::string_view& key, Value& value, bool& done) {
+            skipWs();
+            if (!started_) {
+                if (!consume('{')) {
+                    return false;
+                }
+                started_ = true;
+                skipWs();
+                if (consume('}')) {
+                    done = true;
+                    return true;
+                }
+            } else {
+                if (consume('}')) {
+                    done = true;
+                    return true;
+                }
+                if (!consume(',')) {
+                    return false;
+                }
+                skipWs();
+            }
+
+            if (!parseString(key)) {
+                return false;
+            }
+            skipWs();
+            if (!consume(':')) {
+                return false;
+            }
+            skipWs();
+            if (!parseValue(value)) {
+                return false;
+            }
+            skipWs();
+            return true;
+        }
+
+        [[nodiscard]] bool atEnd() {
+            skipWs();
+            return pos_ == json_.size();
+        }
+
+    private:
+        void skipWs() {
+            while (pos_ < json_.size() &&
+                   (json_[pos_] == ' ' || json_[pos_] == '\t' ||
+                    json_[pos_] == '\n' || json_[pos_] == '\r')) {
+                ++pos_;
+            }
+        }
+
+        bool consume(char c) {
+            if (pos_ < json_.size() && json_[pos_] == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        bool parseString(std::string_view& out) {
+            if (!consume('"')) {
+                return false;
+            }
+            const size_t start = pos_;
+            while (pos_ < json_.size()) {
+                const char c = json_[pos_];
+                if (c == '"') {
+                    out = json_.substr(start, pos_ - start);
+                    ++pos_;
+                    return true;
+                }
+                // 转义与控制字符交给完整解析器
+                if (c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+                    return false;
+                }
+                ++pos_;
+            }
+            return false;
+        }
+
+        bool parseValue(Value& value) {
+            if (pos_ >= json_.size()) {
+                return false;
+            }
+            const char c = json_[pos_];
+            if (c == '"') {
+                value.type = Value::Type::String;
+                return parseString(value.str);
+            }
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                value.type = Value::Type::Integer;
+                return parseInteger(value.integer);
+            }
+            for (std::string_view literal : {"true", "false", "null"}) {
+                if (json_.substr(pos_, literal.size()) == literal) {
+                    value.type = Value::Type::Literal;
+                    value.str = literal;
+                    pos_ += literal.size();
+                    return true;
+                }
+            }
+            // 嵌套对象 / 数组
+            return false;
+        }
+
+        bool parseInteger(int64_t& out) {
+            bool negative = consume('-');
+            const size_t start = pos_;
+            uint64_t value = 0;
+            while (pos_ < json_.size() && json_[pos_] >= '0' && json_[pos_] <= '9') {
+                if (pos_ - start >= 18) {
+                    return false;
+                }
+                value = value * 10 + static_cast<uint64_t>(json_[pos_] - '0');
+                ++pos_;
+            }
+            if (pos_ == start) {
+                return false;
+            }
+            // 小数 / 指数交给完整解析器
+            if (pos_ < json_.size() &&
+                (json_[pos_] == '.' || json_[pos_] == 'e' || json_[pos_] == 'E')) {
+                return false;
+            }
+            out = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+            return true;
+        }
+
+        std::string_view json_;
+        size_t pos_{0};
+        bool started_{false};
+    };
+
+    // 线程内复用的 HMAC-SHA256 上下文：一次性 HMAC() 每次都会新建摘要与 MAC 上下文（十余次 malloc），
+    // 这里只在首次使用和密钥变化时设置密钥，之后每次验证只重置状态
+    class Hs256Context {
+    public:
+        Hs256Context() {
+            mac_.reset(EVP_MAC_fetch(nullptr, OSSL_MAC_NAME_HMAC, nullptr));
+            if (mac_) {
+                ctx_.reset(EVP_MAC_CTX_new(mac_.get()));
+            }
+        }
+
+        bool compute(std::string_view secret, std::string_view data,
+                     unsigned char* out, size_t& outLen, size_t capacity) {
+            if (!ctx_) {
+                return false;
+            }
+
+            bool initialized;
+            if (keyed_ && secret == key_) {
+                initialized = EVP_MAC_init(ctx_.get(), nullptr, 0, nullptr) == 1;
+            } else {
+                char digest[] = "SHA256";
+                OSSL_PARAM params[] = {
+                    OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+                    OSSL_PARAM_construct_end(),
+                };
+                initialized = EVP_MAC_init(ctx_.get(),
+                                           reinterpret_cast<const unsigned char*>(secret.data()),
+                                           secret.size(), params) == 1;
+                keyed_ = initialized;
+                key_.assign(initialized ? secret : std::string_view());
+            }
+
+            return initialized &&
+                   EVP_MAC_update(ctx_.get(), reinterpret_cast<const unsigned char*>(data.data()), data.size()) == 1 &&
+                   EVP_MAC_final(ctx_.get(), out, &outLen, capacity) == 1;
+        }
+
+    private:
+        struct MacDeleter {
+            void operator()(EVP_MAC* mac) const noexcept { EVP_MAC_free(mac); }
+        };
+        struct CtxDeleter {
+            void operator()(EVP_MAC_CTX* ctx) const noexcept { EVP_MAC_CTX_free(ctx); }
+        };
+
+        std::unique_ptr<EVP_MAC, MacDeleter> mac_;
+        std::unique_ptr<EVP_MAC_CTX, CtxDeleter> ctx_;
+        std::string key_;
+        bool keyed_{false};
+    };
+
+    template <typename OnField>
+    bool scanObject(std::string_view json, OnField&& onField) {
+        FlatObjectScanner scanner(json);
+        std::string_view key;
+        FlatObjectScanner::Value value{};
+        bool done = false;
+        while (true) {
+            if (!scanner.next(key, value, done)) {
+                return false;
+            }
+            if (done) {
+                return scanner.atEnd();
+            }
+            if (!onField(key, value)) {
+                return false;
+            }
+        }
+    }
+
+} // namespace
+
+std::optional<Segments> split(std::string_view token) {
+    const auto first = token.find('.');
+    if (first == std::string_view::npos) {
+        return std::nullopt;
+    }
+    const auto second = token.find('.', first + 1);
+    if (second == std::string_view::npos || token.find('.', second + 1) != std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    Segments segments;
+    segments.header = token.substr(0, first);
+    segments.payload = token.substr(first + 1, second - first - 1);
+    segments.signature = token.substr(second + 1);
+    segments.signingInput = token.substr(0, second);
+    return segments;
+}
+
+std::optional<size_t> decodeBase64Url(std::string_view input, char* out, size_t capacity) {
+    return utils::codec::base64Decode(input, out, capacity, utils::codec::Base64Alphabet::Url);
+}
+
+bool parseHeader(std::string_view json, Header& out) {
+    return scanObject(json, [&out](std::string_view key, const FlatObjectScanner::Value& value) {
+        if (key == "alg" || key == "kid") {
+            if (value.type != FlatObjectScanner::Value::Type::String) {
+                return false;
+            }
+            (key == "alg" ? out.alg : out.kid) = value.str;
+        }
+        return true;
+    });
+}
+
+bool parseClaims(std::string_view json, Claims& out) {
+    using Type = FlatObjectScanner::Value::Type;
+    return scanObject(json, [&out](std::string_view key, const FlatObjectScanner::Value& value) {
+        auto setString = [&value](std::string_view& field) {
+            if (value.type != Type::String) {
+                return false;
+            }
+            field = value.str;
+            return true;
+        };
+        auto setInteger = [&value](std::optional<int64_t>& field) {
+            if (value.type != Type::Integer) {
+                return false;
+            }
+            field = value.integer;
+            return true;
+        };
+
+        if (key == "iss") return setString(out.iss);
+        if (key == "userId") return setString(out.userId);
+        if (key == "username") return setString(out.username);
+        if (key == "role") return setString(out.role);
+        if (key == "jti") return setString(out.jti);
+        if (key == "exp") return setInteger(out.exp);
+        if (key == "iat") return setInteger(out.iat);
+        if (key == "nbf") return setInteger(out.nbf);
+        // aud 可能是数组，出现时交给完整解析器
+        if (key == "aud") return false;
+        return true;
+    });
+}
+
+bool decodeHeader(std::string_view token, Decoded& out) {
+    auto segments = split(token);
+    if (!segments) {
+        return false;
+    }
+    out.segments = *segments;
+
+    auto headerLen = decodeBase64Url(out.segments.header, out.headerBuffer, sizeof(out.headerBuffer));
+    return headerLen &&
+           parseHeader(std::string_view(out.headerBuffer, *headerLen), out.header) &&
+           out.header.alg == "HS256";
+}
+
+Result verifyToken(std::string_view secret, std::string_view issuer, int64_t now, Decoded& token) {
+    // 先校验签名，再解析载荷
+    if (!verifyHs256(secret, token.segments)) {
+        token.rejectReason = "invalid signature";
+        return Result::Rejected;
+    }
+
+    auto payloadLen = decodeBase64Url(token.segments.payload, token.payloadBuffer, sizeof(token.payloadBuffer));
+    if (!payloadLen || !parseClaims(std::string_view(token.payloadBuffer, *payloadLen), token.claims)) {
+        return Result::Unsupported;
+    }
+
+    const auto& claims = token.claims;
+    if (claims.iss != issuer || !claims.exp || !claims.iat ||
+        claims.userId.empty() || claims.username.empty() || claims.role.empty()) {
+        return Result::Unsupported;
+    }
+    if (now > *claims.exp || now < *claims.iat || (claims.nbf && now < *claims.nbf)) {
+        token.rejectReason = "token expired or not yet valid";
+        return Result::Rejected;
+    }
+    return Result::Verified;
+}
+
+bool verifyHs256(std::string_view secret, const Segments& segments) {
+    thread_local Hs256Context hmac;
+    unsigned char expected[EVP_MAX_MD_SIZE];
+    size_t expectedLen = 0;
+    if (!hmac.compute(secret, segments.signingInput, expected, expectedLen, sizeof(expected))) {
+        return false;
+    }
+
+    char actual[48];
+    auto actualLen = decodeBase64Url(segments.signature, actual, sizeof(actual));
+    if (!actualLen) {
+        return false;
+    }
+
+    return utils::Crypto::constantTimeEquals(
+        std::string_view(actual, *actualLen),
+        std::string_view(reinterpret_cast<const char*>(expected), expectedLen));
+}
+
+} // namespace middleware::jwtfast
\ No newline at end of file
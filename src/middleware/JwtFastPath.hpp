@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace middleware::jwtfast {
+
+    // 自签 HS256 Token 的专用校验：拆分、解码、声明扫描都在调用方的栈缓冲区内完成，不做堆分配；
+    // HMAC 复用线程内的 OpenSSL 上下文，但 OpenSSL 每次重置状态仍有少量内部分配。
+    // 写入 JwtPayload 的声明字符串（超出 SSO 时）以及缓存未命中时构建的 AuthContext 也会分配
+
+    // 快速路径结果：通过 / 明确拒绝 / 格式不在预期内（交给 jwt-cpp 处理）
+    enum class Result { Verified, Rejected, Unsupported };
+
+    // 头部与载荷解码缓冲区上限（超出即走 jwt-cpp）
+    inline constexpr size_t HEADER_BUFFER_SIZE = 256;
+    inline constexpr size_t PAYLOAD_BUFFER_SIZE = 1024;
+
+    // 拆分后的 Token 三段（均指向原 Token）
+    struct Segments {
+        std::string_view header;
+        std::string_view payload;
+        std::string_view signature;
+        std::string_view signingInput;  // header.payload
+    };
+
+    // 头部字段（视图指向解码缓冲区）
+    struct Header {
+        std::string_view alg;
+        std::string_view kid;
+    };
+
+    // 我们自己签发的固定声明集合（视图指向解码缓冲区）
+    struct Claims {
+        std::string_view iss;
+        std::string_view userId;
+        std::string_view username;
+        std::string_view role;
+        std::string_view jti;
+        std::optional<int64_t> exp;
+        std::optional<int64_t> iat;
+        std::optional<int64_t> nbf;
+    };
+
+    // 单个 Token 的解码状态：缓冲区随对象放在调用方栈上，各视图指向其中
+    struct Decoded {
+        Segments segments;
+        Header header;
+        Claims claims;
+        const char* rejectReason{nullptr};  // 结果为 Rejected 时的原因（用于日志）
+        char headerBuffer[HEADER_BUFFER_SIZE];
+        char payloadBuffer[PAYLOAD_BUFFER_SIZE];
+    };
+
+    // 第一步：拆分并解析头部，只接受 HS256；返回 false 表示交给 jwt-cpp。调用方随后按 header.kid 选择密钥
+    bool decodeHeader(std::string_view token, Decoded& out);
+
+    // 第二步：校验签名后解析载荷，并做与 jwt-cpp 验证器一致的声明检查（leeway 为 0，now 为秒）
+    Result verifyToken(std::string_view secret, std::string_view issuer, int64_t now, Decoded& token);
+
+    // 按 '.' 拆分，必须恰好三段
+    std::optional<Segments> split(std::string_view token);
+
+    // 原地 base64url 解码到调用方缓冲区，返回解码后长度
+    std::optional<size_t> decodeBase64Url(std::string_view input, char* out, size_t capacity);
+
+    // 单遍扫描扁平 JSON 对象；出现转义、嵌套或小数时返回 false
+    bool parseHeader(std::string_view json, Header& out);
+    bool parseClaims(std::string_view json, Claims& out);
+
+    // 对 header.payload 原始字节计算 HMAC-SHA256（线程内复用上下文），并与签名段常量时间比较
+    bool verifyHs256(std::string_view secret, const Segments& segments);
+
+} // namespace middleware::jwtfast
\ No newline at end of file
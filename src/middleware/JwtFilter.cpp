@@ -2,56 +2,290 @@
 #include "core/Response.hpp"
 #include "core/Constants.hpp"
 #include "core/Exception.hpp"
+#include "services/TokenRevocation.hpp"
+#include "utils/Crypto.hpp"
+#include "utils/FastPath.hpp"
 #include <spdlog/spdlog.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <variant>
 
 namespace middleware {
 
+namespace {
+
+    using Algorithm = std::variant<jwt::algorithm::hs256,
+                                   jwt::algorithm::ed25519,
+                                   jwt::algorithm::es256>;
+    using Verifier = jwt::verifier<jwt::default_clock, jwt::traits::kazuho_picojson>;
+
+    std::string readKeyFile(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            throw std::runtime_error("cannot open jwt key file: " + path);
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    // 吊销标识：jti 解码为原始字节（紧凑的 Redis 键），不带 jti 的旧 Token 使用 MD5
+    std::string tokenIdFor(std::string_view jti, std::string_view token) {
+        char raw[core::constants::JWT_ID_BYTES + 2];
+        auto len = jwtfast::decodeBase64Url(jti, raw, sizeof(raw));
+        if (len && *len == core::constants::JWT_ID_BYTES) {
+            return std::string(raw, *len);
+        }
+        return utils::Crypto::md5(std::string(token));
+    }
+
+    std::string newTokenId() {
+        return utils::Crypto::base64UrlEncode(utils::Crypto::randomBytes(core::constants::JWT_ID_BYTES));
+    }
+
+    // 密钥材料：优先 *_file，其次内联 PEM
+    std::string keyMaterial(const Json::Value& key, const std::string& name) {
+        if (key.isMember(name + "_file")) {
+            return readKeyFile(key[name + "_file"].asString());
+        }
+        return key.get(name, "").asString();
+    }
+
+} // namespace
+
+// 单个密钥：算法对象与对应的验证器均预先构建
+struct JwtUtil::SigningKey {
+    std::string kid;
+    Algorithm algorithm;
+    Verifier verifier;
+    bool canSign{false};
+    std::string hmacSecret;  // 仅 HS256：供快速路径直接计算 HMAC
+};
+
+// 当前生效的密钥集合（构建后不可变，可被多个线程共享）
+// byKid 中 kid 为空的条目用于不带 kid 的旧 Token（jwt.secret）
+struct JwtUtil::Keys {
+    Keys(const std::string& secret, const std::string& iss, const Json::Value& config)
+        : issuer(iss) {
+        if (!secret.empty()) {
+            add("", jwt::algorithm::hs256{secret}, true, secret);
+        }
+
+        for (const auto& key : config["keys"]) {
+            auto kid = key["kid"].asString();
+            if (kid.empty()) {
+                throw std::invalid_argument("jwt key requires kid");
+            }
+
+            auto alg = key.get("alg", "HS256").asString();
+            if (alg == "HS256") {
+                auto hmacSecret = key["secret"].asString();
+                add(kid, jwt::algorithm::hs256{hmacSecret}, true, hmacSecret);
+                continue;
+            }
+
+            auto publicKey = keyMaterial(key, "public_key");
+            auto privateKey = keyMaterial(key, "private_key");
+            if (alg == "EdDSA" || alg == "Ed25519") {
+                add(kid, jwt::algorithm::ed25519(publicKey, privateKey), !privateKey.empty());
+            } else if (alg == "ES256") {
+                add(kid, jwt::algorithm::es256(publicKey, privateKey), !privateKey.empty());
+            } else {
+                throw std::invalid_argument("unsupported jwt alg: " + alg);
+            }
+        }
+
+        auto activeKid = config.get("active_kid", "").asString();
+        auto it = byKid.find(activeKid);
+        if (it == byKid.end() || !it->second.canSign) {
+            throw std::invalid_argument("jwt active key not found or has no private key: " + activeKid);
+        }
+        active = &it->second;
+    }
+
+    void add(const std::string& kid, Algorithm algorithm, bool canSign, std::string hmacSecret = {}) {
+        auto verifier = std::visit([this](const auto& alg) {
+            return Verifier(jwt::verify().allow_algorithm(alg).with_issuer(issuer));
+        }, algorithm);
+        byKid.insert_or_assign(kid, SigningKey{kid, std::move(algorithm), std::move(verifier),
+                                               canSign, std::move(hmacSecret)});
+    }
+
+    [[nodiscard]] const SigningKey* find(std::string_view kid) const {
+        auto it = byKid.find(kid);
+        return it == byKid.end() ? nullptr : &it->second;
+    }
+
+    std::string issuer;
+    // 支持 string_view 直接查找，避免为 kid 构造临时字符串
+    std::unordered_map<std::string, SigningKey, utils::TransparentStringHash, std::equal_to<>> byKid;
+    const SigningKey* active{nullptr};
+};
+
 // 静态成员初始化
 std::string JwtUtil::secret_ = core::constants::JWT_SECRET;
 std::string JwtUtil::issuer_ = core::constants::JWT_ISSUER;
+Json::Value JwtUtil::keyConfig_;
 std::chrono::seconds JwtUtil::expireDuration_ = 
     std::chrono::duration_cast<std::chrono::seconds>(core::constants::JWT_EXPIRE_DURATION);
+TokenCache JwtUtil::cache_;
+std::atomic<std::shared_ptr<const JwtUtil::Keys>> JwtUtil::keys_{
+    std::make_shared<const JwtUtil::Keys>(JwtUtil::secret_, JwtUtil::issuer_, JwtUtil::keyConfig_)};
+std::atomic<uint64_t> JwtUtil::keysVersion_{1};
 
 void JwtUtil::setSecret(const std::string& secret) {
     secret_ = secret;
+    rebuildKeys();
 }
 
 void JwtUtil::setIssuer(const std::string& issuer) {
     issuer_ = issuer;
+    rebuildKeys();
+}
+
+void JwtUtil::loadKeys(const Json::Value& config) {
+    // 先完整构建，失败时保留原有密钥
+    // 未配置 secret 且没有 keys 时与不配置 jwt 块一致，使用默认密钥（JWT_SECRET）；
+    // 配置了 keys 时不再隐式加入默认密钥，避免公开的默认值可以签出有效 Token
+    auto secret = config.get("secret", "").asString();
+    if (!config.isMember("secret") && config.get("keys", Json::Value()).empty()) {
+        secret = core::constants::JWT_SECRET;
+        spdlog::warn("jwt.secret not configured, using the built-in default secret");
+    }
+    auto issuer = config.get("issuer", issuer_).asString();
+    auto keys = std::make_shared<const Keys>(secret, issuer, config);
+
+    secret_ = secret;
+    issuer_ = issuer;
+    keyConfig_ = config;
+    keys_.store(std::move(keys));
+    keysVersion_.fetch_add(1, std::memory_order_release);
+    cache_.clear();
+
+    spdlog::info("JWT keys loaded: count={}, activeKid={}",
+                 currentKeys().byKid.size(), currentKeys().active->kid);
+}
+
+void JwtUtil::rebuildKeys() {
+    keys_.store(std::make_shared<const Keys>(secret_, issuer_, keyConfig_));
+    keysVersion_.fetch_add(1, std::memory_order_release);
+    cache_.clear();
+}
+
+const JwtUtil::Keys& JwtUtil::currentKeys() {
+    // 每个线程持有一份引用，版本号未变时无需触碰共享的 shared_ptr
+    thread_local std::shared_ptr<const Keys> cached;
+    thread_local uint64_t cachedVersion = 0;
+
+    auto version = keysVersion_.load(std::memory_order_acquire);
+    if (cachedVersion != version) {
+        cached = keys_.load();
+        cachedVersion = version;
+    }
+    return *cached;
 }
 
 void JwtUtil::setExpireDuration(std::chrono::seconds duration) {
     expireDuration_ = duration;
 }
 
+void JwtUtil::setCacheCapacity(size_t capacity) {
+    cache_.setCapacity(capacity);
+}
+
 std::string JwtUtil::generate(const std::string& userId,
                                const std::string& username,
                                const std::string& role) {
+    const auto& keys = currentKeys();
+    const auto& key = *keys.active;
     auto now = std::chrono::system_clock::now();
     auto exp = now + expireDuration_;
 
-    auto token = jwt::create()
-        .set_issuer(issuer_)
+    auto builder = jwt::create()
+        .set_issuer(keys.issuer)
         .set_type("JWT")
+        .set_id(newTokenId())
         .set_issued_at(now)
         .set_expires_at(exp)
         .set_payload_claim("userId", jwt::claim(userId))
         .set_payload_claim("username", jwt::claim(username))
-        .set_payload_claim("role", jwt::claim(role))
-        .sign(jwt::algorithm::hs256{secret_});
+        .set_payload_claim("role", jwt::claim(role));
+
+    // 旧密钥（jwt.secret）签发的 Token 不带 kid，保持兼容
+    if (!key.kid.empty()) {
+        builder.set_key_id(key.kid);
+    }
+
+    auto token = std::visit([&builder](const auto& alg) {
+        return builder.sign(alg);
+    }, key.algorithm);
 
     spdlog::debug("JWT generated for user: {}", userId);
     return token;
 }
 
+jwtfast::Result JwtUtil::verifyFast(const Keys& keys, std::string_view token, JwtPayload& payload) {
+    using jwtfast::Result;
+
+    // 头部：仅处理 HS256，且 kid 对应的密钥也是 HS256
+    jwtfast::Decoded decoded;
+    if (!jwtfast::decodeHeader(token, decoded)) {
+        return Result::Unsupported;
+    }
+    const auto* key = keys.find(decoded.header.kid);
+    if (!key || key->hmacSecret.empty()) {
+        return Result::Unsupported;
+    }
+
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    auto result = jwtfast::verifyToken(key->hmacSecret, keys.issuer, now, decoded);
+    if (result != Result::Verified) {
+        if (result == Result::Rejected) {
+            spdlog::warn("JWT verification failed: {}", decoded.rejectReason);
+        }
+        return result;
+    }
+
+    const auto& claims = decoded.claims;
+    auto toTicks = [](int64_t seconds) {
+        return std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::seconds(seconds)).count();
+    };
+    payload.userId.assign(claims.userId);
+    payload.username.assign(claims.username);
+    payload.role.assign(claims.role);
+    payload.exp = toTicks(*claims.exp);
+    payload.iat = toTicks(*claims.iat);
+    payload.tokenId = tokenIdFor(claims.jti, token);
+    return Result::Verified;
+}
+
 std::optional<JwtPayload> JwtUtil::verify(const std::string& token) {
-    try {
-        auto verifier = jwt::verify()
-            .allow_algorithm(jwt::algorithm::hs256{secret_})
-            .with_issuer(issuer_);
+    // 快速路径：自签 HS256 Token 不构建 JSON 树，声明直接从栈缓冲区读取（只在写入 payload 时复制）
+    JwtPayload fast;
+    switch (verifyFast(currentKeys(), token, fast)) {
+        case jwtfast::Result::Verified:
+            return fast;
+        case jwtfast::Result::Rejected:
+            return std::nullopt;
+        case jwtfast::Result::Unsupported:
+            break;
+    }
 
+    try {
         auto decoded = jwt::decode(token);
-        verifier.verify(decoded);
+
+        // 按 kid 选择密钥（O(1) 查找），无 kid 的 Token 使用旧密钥
+        auto kid = decoded.has_key_id() ? decoded.get_key_id() : std::string();
+        const auto* key = currentKeys().find(kid);
+        if (!key) {
+            spdlog::warn("JWT verification failed: unknown kid '{}'", kid);
+            return std::nullopt;
+        }
+        key->verifier.verify(decoded);
 
         JwtPayload payload;
         payload.userId = decoded.get_payload_claim("userId").as_string();
@@ -59,6 +293,7 @@ std::optional<JwtPayload> JwtUtil::verify(const std::string& token) {
         payload.role = decoded.get_payload_claim("role").as_string();
         payload.exp = decoded.get_expires_at().time_since_epoch().count();
         payload.iat = decoded.get_issued_at().time_since_epoch().count();
+        payload.tokenId = tokenIdFor(decoded.has_id() ? decoded.get_id() : std::string(), token);
 
         return payload;
 
@@ -71,6 +306,27 @@ std::optional<JwtPayload> JwtUtil::verify(const std::string& token) {
     }
 }
 
+std::shared_ptr<const AuthContext> JwtUtil::verifyCached(const std::string& token) {
+    auto now = std::chrono::system_clock::now().time_since_epoch().count();
+    if (auto cached = cache_.get(token, now)) {
+        return cached;
+    }
+
+    auto payload = verify(token);
+    if (!payload) {
+        return nullptr;
+    }
+
+    auto ctx = AuthContext::fromPayload(*payload);
+    if (!ctx) {
+        spdlog::warn("JWT verification failed: invalid userId claim");
+        return nullptr;
+    }
+
+    cache_.put(token, ctx);
+    return ctx;
+}
+
 std::optional<std::string> JwtUtil::extractToken(const drogon::HttpRequestPtr& req) {
     auto authHeader = req->getHeader(core::constants::HEADER_AUTHORIZATION);
     
@@ -90,6 +346,20 @@ std::optional<std::string> JwtUtil::extractToken(const drogon::HttpRequestPtr& r
 
 // ==================== JwtFilter ====================
 
+namespace {
+
+    // 将认证上下文存入请求属性并继续处理链
+    void acceptRequest(const drogon::HttpRequestPtr& req,
+                       std::shared_ptr<const AuthContext> ctx,
+                       drogon::FilterChainCallback&& fccb) {
+        spdlog::debug("JWT verified: userId={}, path={}", ctx->userId, req->getPath());
+
+        AuthContext::attach(req, std::move(ctx));
+        fccb();
+    }
+
+} // namespace
+
 void JwtFilter::doFilter(const drogon::HttpRequestPtr& req,
                          drogon::FilterCallback&& fcb,
                          drogon::FilterChainCallback&& fccb) {
@@ -101,9 +371,9 @@ void JwtFilter::doFilter(const drogon::HttpRequestPtr& req,
         return;
     }
 
-    // 验证 Token
-    auto payload = JwtUtil::verify(*token);
-    if (!payload) {
+    // 验证 Token（命中缓存时跳过解码与签名校验）
+    auto ctx = JwtUtil::verifyCached(*token);
+    if (!ctx) {
         spdlog::debug("JWT invalid for request: {}", req->getPath());
         fcb(core::Response::error(core::ErrorCode::TOKEN_INVALID));
         return;
@@ -111,21 +381,41 @@ void JwtFilter::doFilter(const drogon::HttpRequestPtr& req,
 
     // 检查过期
     auto now = std::chrono::system_clock::now().time_since_epoch().count();
-    if (payload->exp < now) {
-        spdlog::debug("JWT expired for user: {}", payload->userId);
+    if (ctx->exp < now) {
+        spdlog::debug("JWT expired for user: {}", ctx->userId);
         fcb(core::Response::error(core::ErrorCode::TOKEN_EXPIRED));
         return;
     }
 
-    // 将用户信息存入请求属性
-    req->getAttributes()->insert("userId", payload->userId);
-    req->getAttributes()->insert("username", payload->username);
-    req->getAttributes()->insert("role", payload->role);
+    // 检查吊销：本地过滤器未命中直接放行，命中时再查询 Redis 确认
+    // 过滤器尚未加载成功（启动期间或 Redis 启动时不可用）时每个请求都查询 Redis
+    if (!services::TokenRevocation::instance().mightBeRevoked(ctx->tokenId)) {
+        acceptRequest(req, std::move(ctx), std::move(fccb));
+        return;
+    }
+
+    drogon::async_run([req, ctx = std::move(ctx), fcb = std::move(fcb), fccb = std::move(fccb)]() mutable
+                      -> drogon::Task<void> {
+        // Redis 不可用时无法确认吊销状态：返回 503 而不是放行，也不告诉客户端 Token 已吊销；
+        // 过滤器未就绪时这会影响所有已认证请求，直到 Redis 恢复
+        bool revoked = false;
+        try {
+            revoked = co_await services::TokenRevocation::instance().isRevoked(ctx->tokenId);
+        } catch (const core::RedisException& e) {
+            spdlog::error("Token revocation check failed: {}", e.what());
+            fcb(core::Response::error(core::ErrorCode::REDIS_CONNECTION_ERROR,
+                                      "token revocation check unavailable"));
+            co_return;
+        }
 
-    spdlog::debug("JWT verified: userId={}, path={}", payload->userId, req->getPath());
+        if (revoked) {
+            spdlog::debug("JWT revoked for user: {}", ctx->userId);
+            fcb(core::Response::error(core::ErrorCode::TOKEN_INVALID, "token revoked"));
+            co_return;
+        }
 
-    // 继续处理链
-    fccb();
+        acceptRequest(req, std::move(ctx), std::move(fccb));
+    });
 }
 
 } // namespace middleware
\ No newline at end of file
@@ -2,8 +2,14 @@
 
 #include <drogon/HttpFilter.h>
 #include <jwt-cpp/jwt.h>
+#include <json/json.h>
 #include <string>
 #include <optional>
+#include <memory>
+#include <atomic>
+#include "TokenCache.hpp"
+#include "JwtFastPath.hpp"
+#include "AuthContext.hpp"
 
 namespace middleware {
 
@@ -14,6 +20,7 @@ namespace middleware {
         std::string role;
         int64_t exp;  // 过期时间
         int64_t iat;  // 签发时间
+        std::string tokenId;  // 吊销标识（jti 的原始字节；旧 Token 无 jti 时为 Token 的 MD5）
     };
 
     // JWT 工具类
@@ -27,18 +34,42 @@ namespace middleware {
         // 验证并解析 Token
         static std::optional<JwtPayload> verify(const std::string& token);
 
+        // 验证 Token 并返回认证上下文（带缓存，重复 Token 只需一次哈希查找并复用同一对象）
+        // 无效返回 nullptr
+        static std::shared_ptr<const AuthContext> verifyCached(const std::string& token);
+
         // 从请求头提取 Token
         static std::optional<std::string> extractToken(const drogon::HttpRequestPtr& req);
 
+        // 从 jwt 配置块加载密钥（支持多 kid 与 HS256 / EdDSA / ES256），可在运行中调用完成轮换
+        // 既无 secret 也无 keys 时使用默认密钥 JWT_SECRET（与不配置 jwt 块相同）
+        // 构建失败时抛出异常并保留原有密钥
+        static void loadKeys(const Json::Value& config);
+
         // 配置
         static void setSecret(const std::string& secret);
         static void setIssuer(const std::string& issuer);
         static void setExpireDuration(std::chrono::seconds duration);
+        static void setCacheCapacity(size_t capacity);
 
     private:
+        struct SigningKey;
+        struct Keys;
+
+        // 重新构建签名 / 验证对象并原子替换
+        static void rebuildKeys();
+        // 当前线程可见的签名 / 验证对象
+        static const Keys& currentKeys();
+        // 专用解析：只识别我们签发的 HS256 Token 与固定声明集合，其余交给 jwt-cpp
+        static jwtfast::Result verifyFast(const Keys& keys, std::string_view token, JwtPayload& payload);
+
         static std::string secret_;
         static std::string issuer_;
+        static Json::Value keyConfig_;
         static std::chrono::seconds expireDuration_;
+        static TokenCache cache_;
+        static std::atomic<std::shared_ptr<const Keys>> keys_;
+        static std::atomic<uint64_t> keysVersion_;
     };
 
     // JWT 认证过滤器
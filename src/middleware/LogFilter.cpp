@@ -1,10 +1,27 @@
 #include "LogFilter.hpp"
+#include "AccessLog.hpp"
 #include "core/Constants.hpp"
 #include "utils/Crypto.hpp"
+#include "trace/Tracer.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <string_view>
 
 namespace middleware {
 
+namespace {
+
+    // 复制到定长字段（超长截断，保证以 '\0' 结尾）
+    template <size_t N>
+    void copyTruncated(char (&dst)[N], std::string_view src) {
+        auto len = std::min(src.size(), N - 1);
+        std::memcpy(dst, src.data(), len);
+        dst[len] = '\0';
+    }
+
+} // namespace
+
     void RequestContext::start() {
         startTime_ = std::chrono::steady_clock::now();
     }
@@ -30,7 +47,7 @@ namespace middleware {
         // 生成或获取请求 ID
         auto requestId = req->getHeader(core::constants::HEADER_REQUEST_ID);
         if (requestId.empty()) {
-            requestId = utils::Crypto::uuid();
+            requestId = utils::Crypto::uuidV7();
         }
 
         // 创建请求上下文
@@ -42,18 +59,30 @@ namespace middleware {
         req->getAttributes()->insert("requestId", requestId);
         req->getAttributes()->insert("requestContext", ctx);
 
-        // 获取客户端 IP
-        auto clientIp = req->getPeerAddr().toIp();
+        // 服务端 Span：沿用上游 traceparent，否则新建 trace（由 Tracer 的处理后切面结束）
+        if (trace::Tracer::instance().enabled()) {
+            auto name = fmt::format("{} {}", req->getMethodString(), req->getMatchedPathPattern());
+            auto span = std::make_shared<trace::Span>(trace::Span::root(
+                name, trace::SpanKind::Server,
+                trace::SpanContext::parse(req->getHeader(core::constants::HEADER_TRACEPARENT))));
+            span->setAttribute("url.path", req->getPath());
+            trace::Tracer::attach(req, std::move(span));
+        }
 
-        // 记录请求开始
-        spdlog::info("[{}] --> {} {} from {}",
-                     requestId,
-                     req->getMethodString(),
-                     req->getPath(),
-                     clientIp);
+        // 访问日志：只写入定长记录，格式化与写出由后台线程完成
+        auto& accessLog = AccessLog::instance();
+        if (accessLog.enabled() && accessLog.admit(req->getMatchedPathPattern())) {
+            AccessRecord record;
+            record.time = std::chrono::system_clock::now();
+            copyTruncated(record.requestId, requestId);
+            copyTruncated(record.method, req->getMethodString());
+            copyTruncated(record.path, req->getPath());
+            copyTruncated(record.clientIp, req->getPeerAddr().toIp());
+            accessLog.submit(record);
+        }
 
-        // 如果有 body，记录（仅 debug 级别）
-        if (spdlog::get_level() <= spdlog::level::debug) {
+        // 请求体仅在显式开启 access_log.log_body 时记录（debug 级别）
+        if (accessLog.logBody() && spdlog::should_log(spdlog::level::debug)) {
             auto body = req->getBody();
             if (!body.empty() && body.size() < 1024) {
                 spdlog::debug("[{}] Body: {}", requestId, body);
@@ -0,0 +1,92 @@
+#include "TokenCache.hpp"
+#include "AuthContext.hpp"
+#include "utils/Crypto.hpp"
+#include <algorithm>
+
+namespace middleware {
+
+TokenCache::TokenCache(size_t capacity, size_t shardCount) {
+    shardCount = std::max<size_t>(1, shardCount);
+    shards_.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+    setCapacity(capacity);
+}
+
+TokenCache::Shard& TokenCache::shardFor(uint64_t hash) {
+    // 高位选分片，低位留给分片内哈希表
+    return *shards_[(hash >> 32) % shards_.size()];
+}
+
+std::shared_ptr<const AuthContext> TokenCache::get(std::string_view token, int64_t now) {
+    const uint64_t hash = std::hash<std::string_view>{}(token);
+    auto& shard = shardFor(hash);
+
+    std::lock_guard<std::mutex> lk(shard.mutex);
+    auto it = shard.index.find(hash);
+    if (it == shard.index.end()) {
+        return nullptr;
+    }
+
+    auto entry = it->second;
+    if (!utils::Crypto::constantTimeEquals(entry->token, token)) {
+        return nullptr;
+    }
+
+    if (entry->context->exp < now) {
+        shard.index.erase(it);
+        shard.lru.erase(entry);
+        return nullptr;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+    return entry->context;
+}
+
+void TokenCache::put(std::string_view token, std::shared_ptr<const AuthContext> context) {
+    const uint64_t hash = std::hash<std::string_view>{}(token);
+    auto& shard = shardFor(hash);
+
+    std::lock_guard<std::mutex> lk(shard.mutex);
+    if (shard.capacity == 0) {
+        return;
+    }
+
+    // 同哈希（同一 Token 或碰撞）直接覆盖
+    if (auto it = shard.index.find(hash); it != shard.index.end()) {
+        it->second->token.assign(token);
+        it->second->context = std::move(context);
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    if (shard.lru.size() >= shard.capacity) {
+        shard.index.erase(shard.lru.back().hash);
+        shard.lru.pop_back();
+    }
+
+    shard.lru.push_front(Entry{hash, std::string(token), std::move(context)});
+    shard.index[hash] = shard.lru.begin();
+}
+
+void TokenCache::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lk(shard->mutex);
+        shard->index.clear();
+        shard->lru.clear();
+    }
+}
+
+void TokenCache::setCapacity(size_t capacity) {
+    const size_t perShard = (capacity + shards_.size() - 1) / shards_.size();
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lk(shard->mutex);
+        shard->index.clear();
+        shard->lru.clear();
+        shard->capacity = perShard;
+        shard->index.reserve(perShard);
+    }
+}
+
+} // namespace middleware
\ No newline at end of file
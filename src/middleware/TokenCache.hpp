@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace middleware {
+
+    struct AuthContext;
+
+    // 已验证 Token 缓存（分片 LRU）
+    // 以 Token 哈希为键，命中时常量时间比较完整 Token，缓存认证上下文直到过期
+    class TokenCache {
+    public:
+        explicit TokenCache(size_t capacity = 65536, size_t shardCount = 16);
+
+        TokenCache(const TokenCache&) = delete;
+        TokenCache& operator=(const TokenCache&) = delete;
+
+        // 查找（now 与 AuthContext::exp 同单位）；未命中或已过期返回 nullptr
+        std::shared_ptr<const AuthContext> get(std::string_view token, int64_t now);
+
+        // 写入已验证 Token 的认证上下文
+        void put(std::string_view token, std::shared_ptr<const AuthContext> context);
+
+        // 清空（密钥变更时调用）
+        void clear();
+
+        // 调整容量（会清空缓存）
+        void setCapacity(size_t capacity);
+
+    private:
+        struct Entry {
+            uint64_t hash;
+            std::string token;
+            std::shared_ptr<const AuthContext> context;
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::list<Entry> lru;  // 头部为最近使用
+            std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+            size_t capacity{0};
+        };
+
+        Shard& shardFor(uint64_t hash);
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+    };
+
+} // namespace middleware
\ No newline at end of file
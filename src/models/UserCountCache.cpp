@@ -0,0 +1,71 @@
+#include "UserCountCache.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace models {
+
+UserCountCache& UserCountCache::instance() {
+    static UserCountCache instance;
+    return instance;
+}
+
+void UserCountCache::configure(const Json::Value& config) {
+    enabled_ = config.get("enabled", true).asBool();
+    approximate_ = config.get("approximate", false).asBool();
+    ttl_ = std::chrono::milliseconds(std::max(0, config.get("ttl_ms", 5000).asInt()));
+    capacity_ = std::max(1u, config.get("capacity", 1024).asUInt());
+
+    if (ttl_.count() == 0) {
+        enabled_ = false;
+    }
+
+    spdlog::info("User count cache: enabled={}, ttl={}ms, capacity={}, approximate={}",
+                 enabled_, ttl_.count(), capacity_, approximate_);
+}
+
+std::optional<int64_t> UserCountCache::get(const std::string& keyword) {
+    if (!enabled_) {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = entries_.find(keyword);
+    if (it == entries_.end()) {
+        return std::nullopt;
+    }
+    if (it->second.expiresAt <= std::chrono::steady_clock::now()) {
+        entries_.erase(it);
+        return std::nullopt;
+    }
+    return it->second.total;
+}
+
+void UserCountCache::put(const std::string& keyword, int64_t total, uint64_t generation) {
+    if (!enabled_) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lk(mutex_);
+    // 在锁内比较代数：invalidate 先递增代数再加锁清空，不会留下旧值
+    if (generation != generation_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    if (entries_.size() >= capacity_ && !entries_.count(keyword)) {
+        std::erase_if(entries_, [now](const auto& item) { return item.second.expiresAt <= now; });
+        if (entries_.size() >= capacity_) {
+            // 关键字基本不重复时直接整体清空，比维护 LRU 更省
+            entries_.clear();
+        }
+    }
+    entries_.insert_or_assign(keyword, Entry{total, now + ttl_});
+}
+
+void UserCountCache::invalidate() {
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> lk(mutex_);
+    entries_.clear();
+}
+
+} // namespace models
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <json/json.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace models {
+
+    // 用户列表总数缓存（按搜索关键字，短 TTL）
+    // 本进程内的插入 / 删除 / 用户名邮箱变更立即使全部条目失效；其他实例的写入最多滞后一个 TTL
+    class UserCountCache {
+    public:
+        // 单例获取
+        static UserCountCache& instance();
+
+        // 读取 user_count_cache 配置
+        void configure(const Json::Value& config);
+
+        [[nodiscard]] bool enabled() const noexcept { return enabled_; }
+
+        // 无关键字时使用表统计信息估算总数（不精确，需显式开启）
+        [[nodiscard]] bool approximate() const noexcept { return approximate_; }
+
+        // 查询前读取当前代数，写回时代数已变化（期间发生过写入）则丢弃结果
+        [[nodiscard]] uint64_t generation() const noexcept {
+            return generation_.load(std::memory_order_acquire);
+        }
+
+        std::optional<int64_t> get(const std::string& keyword);
+        void put(const std::string& keyword, int64_t total, uint64_t generation);
+
+        // 清空全部条目
+        void invalidate();
+
+    private:
+        struct Entry {
+            int64_t total;
+            std::chrono::steady_clock::time_point expiresAt;
+        };
+
+        UserCountCache() = default;
+        UserCountCache(const UserCountCache&) = delete;
+        UserCountCache& operator=(const UserCountCache&) = delete;
+
+        bool enabled_{true};
+        bool approximate_{false};
+        std::chrono::milliseconds ttl_{5000};
+        size_t capacity_{1024};
+
+        std::atomic<uint64_t> generation_{0};
+        std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+    };
+
+} // namespace models
@@ -1,17 +1,36 @@
 #include "UserMapper.hpp"
+#include "UserCountCache.hpp"
+#include "UserSearch.hpp"
 #include "core/Exception.hpp"
 #include "core/Constants.hpp"
+#include "utils/Crypto.hpp"
+#include "utils/Deferred.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <charconv>
+#include <unordered_map>
 
 namespace models {
 
-UserMapper::UserMapper(drogon::orm::DbClientPtr client)
-    : dbClient_(std::move(client)) {
+UserMapper::UserMapper(drogon::orm::DbClientPtr client, trace::SpanContext parent)
+    : dbClient_(std::move(client))
+    , parent_(parent) {
 }
 
-drogon::Task<Users> UserMapper::findById(int64_t id) {
-    auto result = co_await dbClient_->execSqlCoro(
-        "SELECT * FROM users WHERE id = ? LIMIT 1",
+trace::Span UserMapper::querySpan(const std::string& sql) const {
+    if (!parent_.valid()) {
+        return {};
+    }
+    std::string_view text(sql);
+    auto name = fmt::format("mysql {}", text.substr(0, text.find(' ')));
+    trace::Span span(name, trace::SpanKind::Client, parent_);
+    span.setAttribute("db.query.text", text);
+    return span;
+}
+
+drogon::Task<Users> UserMapper::findById(int64_t id, Projection projection) {
+    auto result = co_await query(
+        selectFrom(projection, "WHERE id = ? LIMIT 1"),
         id
     );
     
@@ -19,12 +38,12 @@ drogon::Task<Users> UserMapper::findById(int64_t id) {
         throw core::NotFoundException("user not found: " + std::to_string(id));
     }
     
-    co_return Users(result[0]);
+    co_return Users(result[0], Users::ColumnIndex(result));
 }
 
-drogon::Task<std::optional<Users>> UserMapper::findByIdOptional(int64_t id) {
-    auto result = co_await dbClient_->execSqlCoro(
-        "SELECT * FROM users WHERE id = ? LIMIT 1",
+drogon::Task<std::optional<Users>> UserMapper::findByIdOptional(int64_t id, Projection projection) {
+    auto result = co_await query(
+        selectFrom(projection, "WHERE id = ? LIMIT 1"),
         id
     );
     
@@ -32,12 +51,12 @@ drogon::Task<std::optional<Users>> UserMapper::findByIdOptional(int64_t id) {
         co_return std::nullopt;
     }
     
-    co_return Users(result[0]);
+    co_return Users(result[0], Users::ColumnIndex(result));
 }
 
-drogon::Task<std::optional<Users>> UserMapper::findByUsername(const std::string& username) {
-    auto result = co_await dbClient_->execSqlCoro(
-        "SELECT * FROM users WHERE username = ? LIMIT 1",
+drogon::Task<std::optional<Users>> UserMapper::findByUsername(const std::string& username, Projection projection) {
+    auto result = co_await query(
+        selectFrom(projection, "WHERE username = ? LIMIT 1"),
         username
     );
     
@@ -45,12 +64,12 @@ drogon::Task<std::optional<Users>> UserMapper::findByUsername(const std::string&
         co_return std::nullopt;
     }
     
-    co_return Users(result[0]);
+    co_return Users(result[0], Users::ColumnIndex(result));
 }
 
-drogon::Task<std::optional<Users>> UserMapper::findByEmail(const std::string& email) {
-    auto result = co_await dbClient_->execSqlCoro(
-        "SELECT * FROM users WHERE email = ? LIMIT 1",
+drogon::Task<std::optional<Users>> UserMapper::findByEmail(const std::string& email, Projection projection) {
+    auto result = co_await query(
+        selectFrom(projection, "WHERE email = ? LIMIT 1"),
         email
     );
     
@@ -58,11 +77,11 @@ drogon::Task<std::optional<Users>> UserMapper::findByEmail(const std::string& em
         co_return std::nullopt;
     }
     
-    co_return Users(result[0]);
+    co_return Users(result[0], Users::ColumnIndex(result));
 }
 
 drogon::Task<int64_t> UserMapper::insert(const Users& user) {
-    co_await dbClient_->execSqlCoro(
+    co_await query(
         "INSERT INTO users (username, email, password_hash, salt, role, status, created_at) "
         "VALUES (?, ?, ?, ?, ?, ?, NOW())",
         user.getUsername(),
@@ -74,17 +93,19 @@ drogon::Task<int64_t> UserMapper::insert(const Users& user) {
     );
     
     // 获取自增 ID
-    auto idResult = co_await dbClient_->execSqlCoro("SELECT LAST_INSERT_ID() as id");
+    auto idResult = co_await query("SELECT LAST_INSERT_ID() as id");
     
     if (idResult.empty()) {
         throw core::DbException(core::ErrorCode::DB_QUERY_ERROR, "Failed to get insert id");
     }
+
+    UserCountCache::instance().invalidate();
     
     co_return idResult[0]["id"].as<int64_t>();
 }
 
 drogon::Task<bool> UserMapper::update(const Users& user) {
-    auto result = co_await dbClient_->execSqlCoro(
+    auto result = co_await query(
         "UPDATE users SET username = ?, email = ?, password_hash = ?, salt = ?, "
         "role = ?, status = ?, updated_at = NOW() WHERE id = ?",
         user.getUsername(),
@@ -96,6 +117,9 @@ drogon::Task<bool> UserMapper::update(const Users& user) {
         user.getId()
     );
     
+    if (result.affectedRows() > 0) {
+        UserCountCache::instance().invalidate();
+    }
     co_return result.affectedRows() > 0;
 }
 
@@ -118,30 +142,50 @@ drogon::Task<bool> UserMapper::updateFields(int64_t id,
     drogon::orm::Result result;
     switch (values.size()) {
         case 1:
-            result = co_await dbClient_->execSqlCoro(sql, values[0], id);
+            result = co_await query(sql, values[0], id);
             break;
         case 2:
-            result = co_await dbClient_->execSqlCoro(sql, values[0], values[1], id);
+            result = co_await query(sql, values[0], values[1], id);
             break;
         case 3:
-            result = co_await dbClient_->execSqlCoro(sql, values[0], values[1], values[2], id);
+            result = co_await query(sql, values[0], values[1], values[2], id);
             break;
         case 4:
-            result = co_await dbClient_->execSqlCoro(sql, values[0], values[1], values[2], values[3], id);
+            result = co_await query(sql, values[0], values[1], values[2], values[3], id);
             break;
         default:
             throw core::DbException(core::ErrorCode::DB_QUERY_ERROR, "Too many fields to update");
     }
     
+    // 关键字总数只与用户名、邮箱有关
+    if (result.affectedRows() > 0 &&
+        std::any_of(fields.begin(), fields.end(), [](const auto& field) {
+            return field.first == Users::Cols::username || field.first == Users::Cols::email;
+        })) {
+        UserCountCache::instance().invalidate();
+    }
+    co_return result.affectedRows() > 0;
+}
+
+drogon::Task<bool> UserMapper::replacePasswordHash(int64_t id, const std::string& expectedHash,
+                                                   const std::string& newHash, const std::string& newSalt) {
+    auto result = co_await query(
+        "UPDATE users SET password_hash = ?, salt = ?, updated_at = NOW() "
+        "WHERE id = ? AND password_hash = ?",
+        newHash, newSalt, id, expectedHash
+    );
     co_return result.affectedRows() > 0;
 }
 
 drogon::Task<bool> UserMapper::deleteById(int64_t id) {
-    auto result = co_await dbClient_->execSqlCoro(
+    auto result = co_await query(
         "DELETE FROM users WHERE id = ?",
         id
     );
     
+    if (result.affectedRows() > 0) {
+        UserCountCache::instance().invalidate();
+    }
     co_return result.affectedRows() > 0;
 }
 
@@ -155,55 +199,238 @@ drogon::Task<PageResult> UserMapper::findPage(int page, int pageSize, const std:
     result.page = page;
     result.pageSize = pageSize;
     
+    auto& countCache = UserCountCache::instance();
+    result.approximate = keyword.empty() && countCache.approximate();
+    
+    // 总数未命中缓存时先发出 COUNT，与列表查询并发执行（协程持有 mapper 副本）
+    auto cachedTotal = countCache.get(keyword);
+    std::optional<utils::Deferred<int64_t>> pendingTotal;
+    if (!cachedTotal) {
+        pendingTotal.emplace(utils::Deferred<int64_t>::start(
+            [self = *this, keyword, approximate = result.approximate]() mutable {
+                return self.countTotal(keyword, approximate);
+            }));
+    }
+    
+    drogon::orm::Result listResult;
     if (keyword.empty()) {
         // 无搜索条件
-        auto countResult = co_await dbClient_->execSqlCoro(
-            "SELECT COUNT(*) as total FROM users"
-        );
-        result.total = countResult[0]["total"].as<int64_t>();
-        
-        auto listResult = co_await dbClient_->execSqlCoro(
-            "SELECT * FROM users ORDER BY created_at DESC LIMIT ? OFFSET ?",
-            pageSize, offset
+        static const auto sql = selectFrom(Projection::Api,
+            "ORDER BY created_at DESC, id DESC LIMIT ? OFFSET ?");
+        listResult = co_await query(sql, pageSize, offset);
+    } else if (auto against = UserSearch::instance().againstPhrase(keyword)) {
+        // 全文索引只取候选 ID，再按主键回表
+        auto idResult = co_await query(
+            "SELECT id FROM users WHERE MATCH(username, email) AGAINST(? IN BOOLEAN MODE) "
+            "ORDER BY created_at DESC, id DESC LIMIT ? OFFSET ?",
+            *against, pageSize, offset
         );
-        
-        for (const auto& row : listResult) {
-            result.list.emplace_back(row);
-        }
+        result.list = co_await findByIds(idResult);
     } else {
         // 带搜索条件
         std::string pattern = "%" + keyword + "%";
-        
-        auto countResult = co_await dbClient_->execSqlCoro(
-            "SELECT COUNT(*) as total FROM users WHERE username LIKE ? OR email LIKE ?",
-            pattern, pattern
-        );
-        result.total = countResult[0]["total"].as<int64_t>();
-        
-        auto listResult = co_await dbClient_->execSqlCoro(
-            "SELECT * FROM users WHERE username LIKE ? OR email LIKE ? "
-            "ORDER BY created_at DESC LIMIT ? OFFSET ?",
-            pattern, pattern, pageSize, offset
+        static const auto sql = selectFrom(Projection::Api,
+            "WHERE username LIKE ? OR email LIKE ? ORDER BY created_at DESC, id DESC LIMIT ? OFFSET ?");
+        listResult = co_await query(sql, pattern, pattern, pageSize, offset);
+    }
+    
+    if (!listResult.empty()) {
+        result.list = Users::fromResult(listResult);
+    }
+    
+    result.total = cachedTotal ? *cachedTotal : co_await *pendingTotal;
+    
+    co_return result;
+}
+
+drogon::Task<int64_t> UserMapper::countTotal(const std::string& keyword, bool approximate) {
+    auto& countCache = UserCountCache::instance();
+    const auto generation = countCache.generation();
+    
+    int64_t total = -1;
+    if (approximate) {
+        // InnoDB 统计值，误差可达数十个百分点；统计信息缺失时退回精确计数
+        auto estimate = co_await query(
+            "SELECT TABLE_ROWS AS total FROM information_schema.TABLES "
+            "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = 'users'"
         );
-        
-        for (const auto& row : listResult) {
-            result.list.emplace_back(row);
+        if (!estimate.empty() && !estimate[0]["total"].isNull()) {
+            total = estimate[0]["total"].as<int64_t>();
         }
     }
+    if (total < 0) {
+        total = keyword.empty() ? co_await count() : co_await countByKeyword(keyword);
+    }
     
+    countCache.put(keyword, total, generation);
+    co_return total;
+}
+
+drogon::Task<CursorPageResult> UserMapper::findPageAfter(const std::string& cursor, int pageSize,
+                                                         const std::string& keyword) {
+    if (pageSize < 1) pageSize = core::constants::DEFAULT_PAGE_SIZE;
+    if (pageSize > core::constants::MAX_PAGE_SIZE) pageSize = core::constants::MAX_PAGE_SIZE;
+
+    CursorPageResult result;
+    result.pageSize = pageSize;
+
+    // 多取一行用于判断是否还有下一页
+    const int limit = pageSize + 1;
+    drogon::orm::Result listResult;
+
+    auto against = keyword.empty() ? std::nullopt : UserSearch::instance().againstPhrase(keyword);
+
+    if (cursor.empty()) {
+        if (keyword.empty()) {
+            static const auto sql = selectFrom(Projection::Api,
+                "ORDER BY created_at DESC, id DESC LIMIT ?");
+            listResult = co_await query(sql, limit);
+        } else if (against) {
+            auto idResult = co_await query(
+                "SELECT id FROM users WHERE MATCH(username, email) AGAINST(? IN BOOLEAN MODE) "
+                "ORDER BY created_at DESC, id DESC LIMIT ?",
+                *against, limit
+            );
+            result.list = co_await findByIds(idResult);
+        } else {
+            std::string pattern = "%" + keyword + "%";
+            static const auto sql = selectFrom(Projection::Api,
+                "WHERE username LIKE ? OR email LIKE ? ORDER BY created_at DESC, id DESC LIMIT ?");
+            listResult = co_await query(sql, pattern, pattern, limit);
+        }
+    } else {
+        auto [createdAt, id] = decodeCursor(cursor);
+
+        // 展开为 OR 形式，MySQL 才能对 (created_at, id) 索引做范围扫描
+        if (keyword.empty()) {
+            static const auto sql = selectFrom(Projection::Api,
+                "WHERE (created_at < ? OR (created_at = ? AND id < ?)) "
+                "ORDER BY created_at DESC, id DESC LIMIT ?");
+            listResult = co_await query(sql, createdAt, createdAt, id, limit);
+        } else if (against) {
+            auto idResult = co_await query(
+                "SELECT id FROM users WHERE (created_at < ? OR (created_at = ? AND id < ?)) "
+                "AND MATCH(username, email) AGAINST(? IN BOOLEAN MODE) "
+                "ORDER BY created_at DESC, id DESC LIMIT ?",
+                createdAt, createdAt, id, *against, limit
+            );
+            result.list = co_await findByIds(idResult);
+        } else {
+            std::string pattern = "%" + keyword + "%";
+            static const auto sql = selectFrom(Projection::Api,
+                "WHERE (created_at < ? OR (created_at = ? AND id < ?)) "
+                "AND (username LIKE ? OR email LIKE ?) "
+                "ORDER BY created_at DESC, id DESC LIMIT ?");
+            listResult = co_await query(sql, createdAt, createdAt, id, pattern, pattern, limit);
+        }
+    }
+
+    if (!listResult.empty()) {
+        result.list = Users::fromResult(listResult);
+    }
+    if (result.list.size() > static_cast<size_t>(pageSize)) {
+        result.list.resize(pageSize);
+        result.nextCursor = encodeCursor(result.list.back());
+    }
+
     co_return result;
 }
 
+std::string UserMapper::selectFrom(Projection projection, std::string_view clause) {
+    return fmt::format("SELECT {} FROM users {}", Users::columns(projection), clause);
+}
+
+drogon::Task<std::vector<Users>> UserMapper::findByIds(const drogon::orm::Result& idResult) {
+    std::vector<Users> users;
+    if (idResult.empty()) {
+        co_return users;
+    }
+
+    // ID 来自数据库整型列，直接拼入 IN 列表（参数个数不固定，无法走占位符）
+    std::vector<int64_t> ids;
+    ids.reserve(idResult.size());
+    std::string sql = selectFrom(Projection::Api, "WHERE id IN (");
+    for (const auto& row : idResult) {
+        ids.push_back(row["id"].as<int64_t>());
+        if (ids.size() > 1) {
+            sql += ',';
+        }
+        sql += std::to_string(ids.back());
+    }
+    sql += ')';
+
+    auto rows = co_await query(sql);
+
+    // 按候选顺序输出（IN 查询不保证顺序）；期间被删除的行直接跳过
+    auto fetched = Users::fromResult(rows);
+    std::unordered_map<int64_t, size_t> position;
+    position.reserve(fetched.size());
+    for (size_t i = 0; i < fetched.size(); ++i) {
+        position.emplace(fetched[i].getId(), i);
+    }
+    users.reserve(ids.size());
+    for (auto id : ids) {
+        auto it = position.find(id);
+        if (it != position.end()) {
+            users.push_back(std::move(fetched[it->second]));
+        }
+    }
+    co_return users;
+}
+
+std::string UserMapper::encodeCursor(const Users& user) {
+    return utils::Crypto::base64UrlEncode(
+        fmt::format("{}|{}", user.getCreatedAt(), user.getId()));
+}
+
+std::pair<std::string, int64_t> UserMapper::decodeCursor(const std::string& cursor) {
+    auto decoded = utils::Crypto::base64UrlDecode(cursor);
+    if (!decoded) {
+        throw core::ParamException("invalid cursor");
+    }
+
+    const auto sep = decoded->rfind('|');
+    if (sep == std::string::npos || sep == 0) {
+        throw core::ParamException("invalid cursor");
+    }
+
+    // 时间部分只允许 DATETIME 字符，避免把任意内容带进查询参数
+    std::string_view createdAt(decoded->data(), sep);
+    for (char c : createdAt) {
+        if (!(c >= '0' && c <= '9') && c != '-' && c != ' ' && c != ':' && c != '.') {
+            throw core::ParamException("invalid cursor");
+        }
+    }
+
+    int64_t id = 0;
+    const char* begin = decoded->data() + sep + 1;
+    const char* end = decoded->data() + decoded->size();
+    auto [ptr, ec] = std::from_chars(begin, end, id);
+    if (ec != std::errc() || ptr != end || begin == end || id < 0) {
+        throw core::ParamException("invalid cursor");
+    }
+
+    return {std::string(createdAt), id};
+}
+
 drogon::Task<int64_t> UserMapper::count() {
-    auto result = co_await dbClient_->execSqlCoro(
+    auto result = co_await query(
         "SELECT COUNT(*) as total FROM users"
     );
     co_return result[0]["total"].as<int64_t>();
 }
 
 drogon::Task<int64_t> UserMapper::countByKeyword(const std::string& keyword) {
+    if (auto against = UserSearch::instance().againstPhrase(keyword)) {
+        auto result = co_await query(
+            "SELECT COUNT(*) as total FROM users WHERE MATCH(username, email) AGAINST(? IN BOOLEAN MODE)",
+            *against
+        );
+        co_return result[0]["total"].as<int64_t>();
+    }
+
     std::string pattern = "%" + keyword + "%";
-    auto result = co_await dbClient_->execSqlCoro(
+    auto result = co_await query(
         "SELECT COUNT(*) as total FROM users WHERE username LIKE ? OR email LIKE ?",
         pattern, pattern
     );
@@ -211,7 +438,7 @@ drogon::Task<int64_t> UserMapper::countByKeyword(const std::string& keyword) {
 }
 
 drogon::Task<bool> UserMapper::existsByUsername(const std::string& username) {
-    auto result = co_await dbClient_->execSqlCoro(
+    auto result = co_await query(
         "SELECT 1 FROM users WHERE username = ? LIMIT 1",
         username
     );
@@ -219,7 +446,7 @@ drogon::Task<bool> UserMapper::existsByUsername(const std::string& username) {
 }
 
 drogon::Task<bool> UserMapper::existsByEmail(const std::string& email) {
-    auto result = co_await dbClient_->execSqlCoro(
+    auto result = co_await query(
         "SELECT 1 FROM users WHERE email = ? LIMIT 1",
         email
     );
@@ -228,7 +455,7 @@ drogon::Task<bool> UserMapper::existsByEmail(const std::string& email) {
 
 drogon::Task<bool> UserMapper::existsByUsernameOrEmail(const std::string& username, 
                                                         const std::string& email) {
-    auto result = co_await dbClient_->execSqlCoro(
+    auto result = co_await query(
         "SELECT 1 FROM users WHERE username = ? OR email = ? LIMIT 1",
         username, email
     );
@@ -236,7 +463,7 @@ drogon::Task<bool> UserMapper::existsByUsernameOrEmail(const std::string& userna
 }
 
 drogon::Task<bool> UserMapper::updateLastLoginTime(int64_t id) {
-    auto result = co_await dbClient_->execSqlCoro(
+    auto result = co_await query(
         "UPDATE users SET last_login_at = NOW() WHERE id = ?",
         id
     );
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Users.hpp"
+#include "trace/Span.hpp"
 #include <drogon/drogon.h>
 #include <optional>
+#include <string_view>
 #include <vector>
 
 namespace models {
@@ -13,32 +15,54 @@ namespace models {
         int64_t total{0};
         int page{1};
         int pageSize{10};
+        bool approximate{false};  // total 为表统计估算值
+    };
+
+    // 游标分页结果（nextCursor 为空表示没有下一页）
+    struct CursorPageResult {
+        std::vector<Users> list;
+        std::string nextCursor;
+        int pageSize{10};
     };
 
     // 用户 Mapper（协程版）
     class UserMapper {
     public:
-        explicit UserMapper(drogon::orm::DbClientPtr client);
+        // parent 有效时每条 SQL 记录为其子 Span
+        explicit UserMapper(drogon::orm::DbClientPtr client, trace::SpanContext parent = {});
 
         // 基础 CRUD
-        drogon::Task<Users> findById(int64_t id);
-        drogon::Task<std::optional<Users>> findByIdOptional(int64_t id);
-        drogon::Task<std::optional<Users>> findByUsername(const std::string& username);
-        drogon::Task<std::optional<Users>> findByEmail(const std::string& email);
+        // 单行查询默认取全部列；只读展示用 Projection::Api，登录改密用 Projection::Auth
+        drogon::Task<Users> findById(int64_t id, Projection projection = Projection::Full);
+        drogon::Task<std::optional<Users>> findByIdOptional(int64_t id, Projection projection = Projection::Full);
+        drogon::Task<std::optional<Users>> findByUsername(const std::string& username,
+                                                          Projection projection = Projection::Full);
+        drogon::Task<std::optional<Users>> findByEmail(const std::string& email,
+                                                       Projection projection = Projection::Full);
 
         // 插入（返回自增 ID）
         drogon::Task<int64_t> insert(const Users& user);
 
-        // 更新
+        // 更新（写回全部列，user 须以 Projection::Full 读取）
         drogon::Task<bool> update(const Users& user);
         drogon::Task<bool> updateFields(int64_t id, const std::vector<std::pair<std::string, std::string>>& fields);
 
+        // 仅当 password_hash 仍为 expectedHash 时替换哈希与盐（比较并交换，防止覆盖并发的改密）
+        drogon::Task<bool> replacePasswordHash(int64_t id, const std::string& expectedHash,
+                                               const std::string& newHash, const std::string& newSalt);
+
         // 删除
         drogon::Task<bool> deleteById(int64_t id);
 
-        // 分页查询
+        // 分页查询（列表按 Projection::Api 取列；总数走 UserCountCache，未命中时 COUNT 与列表查询并发执行）
+        // 关键字在开启全文索引时先取候选 ID 再按主键回表，见 UserSearch
         drogon::Task<PageResult> findPage(int page, int pageSize, const std::string& keyword = "");
 
+        // 游标分页（按 (created_at, id) 倒序，cursor 为空取第一页；耗时与翻页深度无关）
+        // 依赖索引 (created_at, id)；cursor 非法时抛出 ParamException
+        drogon::Task<CursorPageResult> findPageAfter(const std::string& cursor, int pageSize,
+                                                     const std::string& keyword = "");
+
         // 计数
         drogon::Task<int64_t> count();
         drogon::Task<int64_t> countByKeyword(const std::string& keyword);
@@ -52,7 +76,35 @@ namespace models {
         drogon::Task<bool> updateLastLoginTime(int64_t id);
 
     private:
+        // 执行 SQL（有父上下文时记录客户端 Span）
+        template <typename... Args>
+        drogon::Task<drogon::orm::Result> query(const std::string& sql, Args&&... args) {
+            auto span = querySpan(sql);
+            try {
+                co_return co_await dbClient_->execSqlCoro(sql, std::forward<Args>(args)...);
+            } catch (...) {
+                span.setError();
+                throw;
+            }
+        }
+
+        [[nodiscard]] trace::Span querySpan(const std::string& sql) const;
+
+        // "SELECT <投影列> FROM users <clause>"
+        static std::string selectFrom(Projection projection, std::string_view clause);
+
+        // 按候选 ID 结果集回表，保持候选顺序
+        drogon::Task<std::vector<Users>> findByIds(const drogon::orm::Result& idResult);
+
+        // 计算总数并写入缓存（approximate 时优先取表统计估算）
+        drogon::Task<int64_t> countTotal(const std::string& keyword, bool approximate);
+
+        // 游标编解码：base64url("created_at|id")
+        static std::string encodeCursor(const Users& user);
+        static std::pair<std::string, int64_t> decodeCursor(const std::string& cursor);
+
         drogon::orm::DbClientPtr dbClient_;
+        trace::SpanContext parent_;
     };
 
 } // namespace models
\ No newline at end of file
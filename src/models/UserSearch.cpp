@@ -0,0 +1,47 @@
+#include "UserSearch.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace models {
+
+namespace {
+
+    // 按 UTF-8 字符计数（ngram 以字符而非字节切分）
+    size_t utf8Length(const std::string& text) {
+        return static_cast<size_t>(std::count_if(text.begin(), text.end(), [](char c) {
+            return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+        }));
+    }
+
+} // namespace
+
+UserSearch& UserSearch::instance() {
+    static UserSearch instance;
+    return instance;
+}
+
+void UserSearch::configure(const Json::Value& config) {
+    fulltext_ = config.get("fulltext", false).asBool();
+    ngramTokenSize_ = std::clamp(config.get("ngram_token_size", 2).asUInt(), 1u, 10u);
+
+    spdlog::info("User search: fulltext={}, ngramTokenSize={}", fulltext_, ngramTokenSize_);
+}
+
+std::optional<std::string> UserSearch::againstPhrase(const std::string& keyword) const {
+    if (!fulltext_) {
+        return std::nullopt;
+    }
+
+    // 整体作为短语匹配（连续 ngram），效果接近 LIKE '%kw%'；
+    // 双引号会提前结束短语、空白会拆分 token，这类关键字仍走 LIKE
+    if (keyword.find_first_of("\" \t\r\n") != std::string::npos) {
+        return std::nullopt;
+    }
+
+    if (utf8Length(keyword) < ngramTokenSize_) {
+        return std::nullopt;
+    }
+    return "\"" + keyword + "\"";
+}
+
+} // namespace models
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <json/json.h>
+#include <optional>
+#include <string>
+
+namespace models {
+
+    // 用户关键字搜索配置
+    // 开启 fulltext 后 username / email 搜索走 MySQL ngram 全文索引，需先关闭停用词再建立索引：
+    //   SET SESSION innodb_ft_enable_stopword = OFF;  -- 与 ALTER 同一会话；或在 my.cnf 中关闭 / 指定空的 innodb_ft_server_stopword_table
+    //   ALTER TABLE users ADD FULLTEXT INDEX ft_users_username_email (username, email) WITH PARSER ngram;
+    // ngram 解析器会丢弃任何包含停用词的 token，默认停用词表含单字母 a / i，
+    // 不关闭时含这两个字母的二元组不会进索引，列表与 COUNT 结果都会与 LIKE '%kw%' 不一致
+    //（已建立的索引需在修改设置后重建）。短于 ngram_token_size 的关键字无法命中 ngram 索引，仍走 LIKE
+    class UserSearch {
+    public:
+        // 单例获取
+        static UserSearch& instance();
+
+        // 读取 user_search 配置
+        void configure(const Json::Value& config);
+
+        [[nodiscard]] bool fulltext() const noexcept { return fulltext_; }
+
+        // 返回 AGAINST(... IN BOOLEAN MODE) 的短语表达式；不适用全文索引时返回 nullopt
+        [[nodiscard]] std::optional<std::string> againstPhrase(const std::string& keyword) const;
+
+    private:
+        UserSearch() = default;
+        UserSearch(const UserSearch&) = delete;
+        UserSearch& operator=(const UserSearch&) = delete;
+
+        bool fulltext_{false};
+        size_t ngramTokenSize_{2};  // 与服务端 ngram_token_size 保持一致
+    };
+
+} // namespace models
@@ -1,7 +1,46 @@
 #include "Users.hpp"
+#include <cstring>
 
 namespace models {
 
+namespace {
+
+    // 列序号，与 ColumnIndex::index_ 一一对应
+    enum Column : size_t {
+        kId, kUsername, kEmail, kPasswordHash, kSalt,
+        kRole, kStatus, kCreatedAt, kUpdatedAt, kLastLoginAt,
+        kColumnCount
+    };
+
+    constexpr const char* COLUMN_NAMES[kColumnCount] = {
+        "id", "username", "email", "password_hash", "salt",
+        "role", "status", "created_at", "updated_at", "last_login_at"
+    };
+
+    template <typename T>
+    void readColumn(const drogon::orm::Row& row, int index, T& out) {
+        if (index < 0) {
+            return;
+        }
+        auto field = row[static_cast<drogon::orm::Row::SizeType>(index)];
+        if (!field.isNull()) {
+            out = field.as<T>();
+        }
+    }
+
+    template <typename T>
+    void readColumn(const drogon::orm::Row& row, int index, std::optional<T>& out) {
+        if (index < 0) {
+            return;
+        }
+        auto field = row[static_cast<drogon::orm::Row::SizeType>(index)];
+        if (!field.isNull()) {
+            out = field.as<T>();
+        }
+    }
+
+} // namespace
+
 // 静态成员初始化
 const std::string Users::tableName = "users";
 const std::string Users::primaryKeyName = "id";
@@ -19,6 +58,68 @@ const std::string Users::Cols::created_at = "created_at";
 const std::string Users::Cols::updated_at = "updated_at";
 const std::string Users::Cols::last_login_at = "last_login_at";
 
+const std::string& Users::columns(Projection projection) {
+    static const std::string api =
+        "id, username, email, role, status, created_at, updated_at, last_login_at";
+    static const std::string auth =
+        "id, username, password_hash, salt, role, status";
+    static const std::string full =
+        "id, username, email, password_hash, salt, role, status, created_at, updated_at, last_login_at";
+
+    switch (projection) {
+        case Projection::Api:
+            return api;
+        case Projection::Auth:
+            return auth;
+        case Projection::Full:
+            break;
+    }
+    return full;
+}
+
+Users::ColumnIndex::ColumnIndex(const drogon::orm::Result& result) {
+    static_assert(std::tuple_size_v<decltype(index_)> == kColumnCount);
+    index_.fill(-1);
+    const auto count = result.columns();
+    for (drogon::orm::Row::SizeType i = 0; i < count; ++i) {
+        const char* name = result.columnName(i);
+        for (size_t col = 0; col < kColumnCount; ++col) {
+            if (std::strcmp(name, COLUMN_NAMES[col]) == 0) {
+                index_[col] = static_cast<int>(i);
+                break;
+            }
+        }
+    }
+}
+
+Users::Users(const drogon::orm::Row& row, const ColumnIndex& columns) {
+    const auto& index = columns.index_;
+    readColumn(row, index[kId], id_);
+    readColumn(row, index[kUsername], username_);
+    readColumn(row, index[kEmail], email_);
+    readColumn(row, index[kPasswordHash], passwordHash_);
+    readColumn(row, index[kSalt], salt_);
+    readColumn(row, index[kRole], role_);
+    readColumn(row, index[kStatus], status_);
+    readColumn(row, index[kCreatedAt], createdAt_);
+    readColumn(row, index[kUpdatedAt], updatedAt_);
+    readColumn(row, index[kLastLoginAt], lastLoginAt_);
+}
+
+std::vector<Users> Users::fromResult(const drogon::orm::Result& result) {
+    std::vector<Users> users;
+    if (result.empty()) {
+        return users;
+    }
+
+    const ColumnIndex columns(result);
+    users.reserve(result.size());
+    for (const auto& row : result) {
+        users.emplace_back(row, columns);
+    }
+    return users;
+}
+
 Users::Users(const drogon::orm::Row& row) {
     if (!row["id"].isNull()) {
         id_ = row["id"].as<int64_t>();
@@ -6,12 +6,20 @@
 #include <drogon/orm/Mapper.h>
 #include <drogon/orm/Criteria.h>
 #include <json/json.h>
+#include <array>
 #include <string>
 #include <optional>
 #include <cstdint>
 
 namespace models {
 
+// 查询投影：只选出调用方需要的列
+enum class Projection : uint8_t {
+    Api,   // 接口展示（不含 password_hash、salt）
+    Auth,  // 登录与改密（id、username、password_hash、salt、role、status）
+    Full,  // 全部列
+};
+
 class Users {
 public:
     // 表名
@@ -36,9 +44,26 @@ public:
     static const bool hasPrimaryKey;
     static const bool hasAutoIncrementPrimary;
 
+    // 投影对应的列清单（用于 SELECT）
+    static const std::string& columns(Projection projection);
+
+    // 结果集列下标（每个结果集解析一次，逐行按下标解码，未选出的列保持默认值）
+    class ColumnIndex {
+    public:
+        explicit ColumnIndex(const drogon::orm::Result& result);
+
+    private:
+        friend class Users;
+        std::array<int, 10> index_;
+    };
+
     // 构造函数
     Users() = default;
     explicit Users(const drogon::orm::Row& row);
+    Users(const drogon::orm::Row& row, const ColumnIndex& columns);
+
+    // 解码整个结果集
+    static std::vector<Users> fromResult(const drogon::orm::Result& result);
 
     // Getter
     [[nodiscard]] int64_t getId() const { return id_; }
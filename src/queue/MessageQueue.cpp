@@ -16,6 +16,9 @@ std::string Message::serialize() const {
     json["payload"] = payload;
     json["timestamp"] = timestamp;
     json["retryCount"] = retryCount;
+    if (!traceparent.empty()) {
+        json["traceparent"] = traceparent;
+    }
 
     Json::StreamWriterBuilder builder;
     builder["indentation"] = "";
@@ -39,6 +42,7 @@ Message Message::deserialize(const std::string& data) {
     msg.payload = json["payload"];
     msg.timestamp = json["timestamp"].asInt64();
     msg.retryCount = json["retryCount"].asInt();
+    msg.traceparent = json.get("traceparent", "").asString();
     return msg;
 }
 
@@ -69,32 +73,45 @@ std::string MessageQueue::buildKey(const std::string& queueName) const {
     return std::string(core::constants::REDIS_QUEUE_PREFIX) + queueName;
 }
 
-drogon::Task<bool> MessageQueue::publish(const std::string& queueName, const Message& message) {
+drogon::Task<bool> MessageQueue::publish(const std::string& queueName, const Message& message,
+                                         trace::SpanContext parent) {
+    trace::Span span(fmt::format("publish {}", queueName), trace::SpanKind::Producer, parent);
+    span.setAttribute("messaging.message.id", message.id);
+
     bool full = co_await isFull(queueName);
     if (full) {
         spdlog::warn("Queue is full: {}", queueName);
+        span.setError();
         throw core::QueueException(core::ErrorCode::QUEUE_FULL);
     }
 
     try {
-        auto& redis = utils::Redis::instance();
+        auto redis = utils::Redis::instance().traced(span.context());
         const auto key = buildKey(queueName);
-        co_await redis.lpush(key, message.serialize());
+        if (span.context().valid()) {
+            auto traced = message;
+            traced.traceparent = span.context().traceparent();
+            co_await redis.lpush(key, traced.serialize());
+        } else {
+            co_await redis.lpush(key, message.serialize());
+        }
 
         spdlog::debug("Message published: queue={}, id={}, type={}",
                       queueName, message.id, message.type);
         co_return true;
     } catch (const core::RedisException& e) {
         spdlog::error("Failed to publish message: {}", e.what());
+        span.setError();
         co_return false;
     }
 }
 
 drogon::Task<bool> MessageQueue::publish(const std::string& queueName,
                                           const std::string& type,
-                                          const Json::Value& payload) {
+                                          const Json::Value& payload,
+                                          trace::SpanContext parent) {
     Message msg;
-    msg.id = utils::Crypto::uuid();
+    msg.id = utils::Crypto::uuidV7();
     msg.type = type;
     msg.payload = payload;
     msg.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -102,7 +119,7 @@ drogon::Task<bool> MessageQueue::publish(const std::string& queueName,
     ).count();
     msg.retryCount = 0;
 
-    co_return co_await publish(queueName, msg);
+    co_return co_await publish(queueName, msg, parent);
 }
 
 void MessageQueue::startConsumers(const std::string& queueName) {
@@ -134,6 +151,7 @@ drogon::Task<void> MessageQueue::consumerTask(const std::string& queueName) {
     auto& redis = utils::Redis::instance();
 
     spdlog::info("Consumer started for queue: {}", queueName);
+    runningConsumers_.fetch_add(1, std::memory_order_relaxed);
 
     while (running_) {
         bool shouldSleep = false;
@@ -149,7 +167,18 @@ drogon::Task<void> MessageQueue::consumerTask(const std::string& queueName) {
             try {
                 auto message = Message::deserialize(data);
 
+                // 消费端 Span：延续消息携带的生产端上下文（重试时沿用原上下文）
+                auto span = trace::Span::root(fmt::format("process {}", queueName),
+                                              trace::SpanKind::Consumer,
+                                              trace::SpanContext::parse(message.traceparent));
+                span.setAttribute("messaging.message.id", message.id);
+
                 bool success = co_await processMessage(message);
+                if (!success) {
+                    span.setError();
+                }
+                span.end();
+
                 if (!success) {
                     // 处理失败，加入重试
                     co_await retryMessage(queueName, std::move(message));
@@ -169,6 +198,7 @@ drogon::Task<void> MessageQueue::consumerTask(const std::string& queueName) {
         }
     }
 
+    runningConsumers_.fetch_sub(1, std::memory_order_relaxed);
     spdlog::info("Consumer stopped for queue: {}", queueName);
 }
 
@@ -179,9 +209,11 @@ drogon::Task<bool> MessageQueue::processMessage(const Message& message) {
         co_return true;  // 无处理器，视为成功（丢弃消息）
     }
 
+    inFlightMessages_.fetch_add(1, std::memory_order_relaxed);
     try {
         spdlog::debug("Processing message: id={}, type={}", message.id, message.type);
         bool success = co_await it->second(message);
+        inFlightMessages_.fetch_sub(1, std::memory_order_relaxed);
 
         if (success) {
             spdlog::debug("Message processed successfully: id={}", message.id);
@@ -191,6 +223,7 @@ drogon::Task<bool> MessageQueue::processMessage(const Message& message) {
 
         co_return success;
     } catch (const std::exception& e) {
+        inFlightMessages_.fetch_sub(1, std::memory_order_relaxed);
         spdlog::error("Message handler exception: id={}, error={}", message.id, e.what());
         co_return false;
     }
@@ -6,6 +6,7 @@
 #include <atomic>
 #include <unordered_map>
 #include <json/json.h>
+#include "trace/Span.hpp"
 
 namespace queue {
 
@@ -16,6 +17,7 @@ struct Message {
     Json::Value payload;      // 消息内容
     int64_t timestamp;        // 时间戳
     int retryCount = 0;       // 重试次数
+    std::string traceparent;  // 生产端 Span 上下文（W3C traceparent，可为空）
 
     // 序列化
     [[nodiscard]] std::string serialize() const;
@@ -43,12 +45,15 @@ public:
     void registerHandler(const std::string& messageType, MessageHandler handler);
 
     // 生产者：发送消息（协程）
-    drogon::Task<bool> publish(const std::string& queueName, const Message& message);
+    // parent 有效时记录 Producer Span，并将其上下文写入消息供消费端延续
+    drogon::Task<bool> publish(const std::string& queueName, const Message& message,
+                               trace::SpanContext parent = {});
 
     // 便捷方法：发送消息（协程）
     drogon::Task<bool> publish(const std::string& queueName,
                                const std::string& type,
-                               const Json::Value& payload);
+                               const Json::Value& payload,
+                               trace::SpanContext parent = {});
 
     // 启动消费者
     void startConsumers(const std::string& queueName);
@@ -62,6 +67,10 @@ public:
     // 队列是否已满（协程）
     drogon::Task<bool> isFull(const std::string& queueName);
 
+    // 运行中的消费者协程数 / 正在处理的消息数（供运行时监控）
+    [[nodiscard]] int runningConsumers() const { return runningConsumers_.load(std::memory_order_relaxed); }
+    [[nodiscard]] int inFlightMessages() const { return inFlightMessages_.load(std::memory_order_relaxed); }
+
     // 配置
     void setMaxQueueSize(size_t size);
     void setMaxRetries(int retries);
@@ -86,6 +95,8 @@ private:
 
     std::unordered_map<std::string, MessageHandler> handlers_;
     std::atomic<bool> running_{false};
+    std::atomic<int> runningConsumers_{0};
+    std::atomic<int> inFlightMessages_{0};
 
     size_t maxQueueSize_ = 10000;
     int maxRetries_ = 3;
@@ -1,9 +1,11 @@
 #include "AuthService.hpp"
+#include "TokenRevocation.hpp"
 #include "models/UserMapper.hpp"
 #include "core/Exception.hpp"
 #include "core/Constants.hpp"
 #include "utils/Redis.hpp"
 #include "utils/Crypto.hpp"
+#include "utils/PasswordHasher.hpp"
 #include "middleware/JwtFilter.hpp"
 #include <spdlog/spdlog.h>
 
@@ -14,14 +16,10 @@ AuthService& AuthService::instance() {
     return instance;
 }
 
-std::string AuthService::buildBlacklistKey(const std::string& token) const {
-    return std::string(core::constants::REDIS_TOKEN_PREFIX) + "blacklist:" +
-           utils::Crypto::md5(token);
-}
-
 drogon::Task<RegisterResult> AuthService::registerUser(const std::string& username,
                                                         const std::string& password,
-                                                        const std::string& email) {
+                                                        const std::string& email,
+                                                        trace::SpanContext parent) {
     // 参数验证
     if (username.empty() || password.empty()) {
         throw core::ParamException("username and password required");
@@ -36,7 +34,7 @@ drogon::Task<RegisterResult> AuthService::registerUser(const std::string& userna
     }
 
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
     // 检查用户是否已存在
     bool exists = co_await mapper.existsByUsernameOrEmail(username, email);
@@ -46,7 +44,7 @@ drogon::Task<RegisterResult> AuthService::registerUser(const std::string& userna
 
     // 生成盐值和密码哈希
     auto salt = utils::Crypto::generateSalt();
-    auto passwordHash = utils::Crypto::hashPassword(password, salt);
+    auto passwordHash = co_await utils::PasswordHasher::instance().hash(password, salt);
 
     // 构建用户对象
     models::Users user;
@@ -69,16 +67,17 @@ drogon::Task<RegisterResult> AuthService::registerUser(const std::string& userna
 }
 
 drogon::Task<LoginResult> AuthService::login(const std::string& username,
-                                              const std::string& password) {
+                                              const std::string& password,
+                                              trace::SpanContext parent) {
     if (username.empty() || password.empty()) {
         throw core::ParamException("username and password required");
     }
 
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
     // 查询用户
-    auto userOpt = co_await mapper.findByUsername(username);
+    auto userOpt = co_await mapper.findByUsername(username, models::Projection::Auth);
     if (!userOpt) {
         throw core::AppException(core::ErrorCode::USER_NOT_FOUND);
     }
@@ -90,11 +89,30 @@ drogon::Task<LoginResult> AuthService::login(const std::string& username,
         throw core::AppException(core::ErrorCode::USER_DISABLED);
     }
 
-    // 验证密码
-    if (!utils::Crypto::verifyPassword(password, user.getSalt(), user.getPasswordHash())) {
+    // 验证密码（在密码哈希线程池上计算）
+    auto& hasher = utils::PasswordHasher::instance();
+    auto check = co_await hasher.verify(password, user.getSalt(), user.getPasswordHash());
+    if (!check.matched) {
         throw core::AppException(core::ErrorCode::PASSWORD_INCORRECT);
     }
 
+    // 旧格式或参数过低的哈希在登录成功后透明升级；失败不影响本次登录
+    if (check.needsRehash) {
+        try {
+            auto newSalt = utils::Crypto::generateSalt();
+            auto newHash = co_await hasher.hash(password, newSalt);
+            // 只在哈希未被并发改密替换时写回，否则保留新密码
+            if (co_await mapper.replacePasswordHash(user.getId(), user.getPasswordHash(), newHash, newSalt)) {
+                spdlog::info("Password hash upgraded: userId={}", user.getId());
+            } else {
+                spdlog::info("Password hash upgrade skipped: userId={}, hash changed concurrently",
+                             user.getId());
+            }
+        } catch (const std::exception& e) {
+            spdlog::warn("Password hash upgrade skipped: userId={}, error={}", user.getId(), e.what());
+        }
+    }
+
     // 生成 Token
     auto token = middleware::JwtUtil::generate(
         std::to_string(user.getId()),
@@ -121,28 +139,30 @@ drogon::Task<LoginResult> AuthService::login(const std::string& username,
     };
 }
 
-drogon::Task<bool> AuthService::logout(int64_t userId, const std::string& token) {
-    // 将 Token 加入黑名单
-    auto& redis = utils::Redis::instance();
-    auto key = buildBlacklistKey(token);
-
-    // 黑名单过期时间与 Token 过期时间一致
-    auto ttl = std::chrono::duration_cast<std::chrono::seconds>(
-        core::constants::JWT_EXPIRE_DURATION
-    );
+drogon::Task<bool> AuthService::logout(int64_t userId,
+                                       const std::string& tokenId,
+                                       std::chrono::system_clock::time_point expiresAt,
+                                       trace::SpanContext parent) {
+    // 将 Token 加入黑名单，并广播到其他节点的本地过滤器
+    // 黑名单只需保留到 Token 自身过期（向上取整到秒）
+    auto remaining = std::chrono::ceil<std::chrono::seconds>(
+        expiresAt - std::chrono::system_clock::now());
+    if (remaining <= std::chrono::seconds::zero()) {
+        co_return true;
+    }
 
-    co_await redis.setEx(key, "1", ttl);
+    co_await TokenRevocation::instance().revoke(tokenId, remaining, parent);
 
     spdlog::info("User logged out: userId={}", userId);
     co_return true;
 }
 
-drogon::Task<LoginResult> AuthService::refreshToken(int64_t userId) {
+drogon::Task<LoginResult> AuthService::refreshToken(int64_t userId, trace::SpanContext parent) {
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
     // 查询用户
-    auto user = co_await mapper.findById(userId);
+    auto user = co_await mapper.findById(userId, models::Projection::Auth);
 
     if (user.getStatus() != 1) {
         throw core::AppException(core::ErrorCode::USER_DISABLED);
@@ -170,33 +190,34 @@ drogon::Task<LoginResult> AuthService::refreshToken(int64_t userId) {
     };
 }
 
-drogon::Task<bool> AuthService::isTokenBlacklisted(const std::string& token) {
-    auto& redis = utils::Redis::instance();
-    auto key = buildBlacklistKey(token);
-    co_return co_await redis.exists(key);
+drogon::Task<bool> AuthService::isTokenBlacklisted(const std::string& tokenId) {
+    co_return co_await TokenRevocation::instance().isRevoked(tokenId);
 }
 
 drogon::Task<bool> AuthService::changePassword(int64_t userId,
                                                 const std::string& oldPassword,
-                                                const std::string& newPassword) {
+                                                const std::string& newPassword,
+                                                trace::SpanContext parent) {
     if (newPassword.length() < 6) {
         throw core::ParamException("new password must be at least 6 characters");
     }
 
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
     // 查询用户
-    auto user = co_await mapper.findById(userId);
+    auto user = co_await mapper.findById(userId, models::Projection::Auth);
 
     // 验证旧密码
-    if (!utils::Crypto::verifyPassword(oldPassword, user.getSalt(), user.getPasswordHash())) {
+    auto& hasher = utils::PasswordHasher::instance();
+    auto check = co_await hasher.verify(oldPassword, user.getSalt(), user.getPasswordHash());
+    if (!check.matched) {
         throw core::AppException(core::ErrorCode::PASSWORD_INCORRECT);
     }
 
     // 生成新盐值和哈希
     auto newSalt = utils::Crypto::generateSalt();
-    auto newHash = utils::Crypto::hashPassword(newPassword, newSalt);
+    auto newHash = co_await hasher.hash(newPassword, newSalt);
 
     // 更新密码
     std::vector<std::pair<std::string, std::string>> fields = {
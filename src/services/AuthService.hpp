@@ -1,7 +1,9 @@
 #pragma once
 
 #include <string>
+#include <chrono>
 #include <drogon/drogon.h>
+#include "trace/Span.hpp"
 
 namespace services {
 
@@ -25,37 +27,42 @@ namespace services {
         // 单例获取
         static AuthService& instance();
 
+        // 以下接口的 parent 为调用方 Span 上下文，数据库/Redis 访问记录为其子 Span
+
         // 用户注册
         drogon::Task<RegisterResult> registerUser(const std::string& username,
                                                    const std::string& password,
-                                                   const std::string& email);
+                                                   const std::string& email,
+                                                   trace::SpanContext parent = {});
 
         // 用户登录
         drogon::Task<LoginResult> login(const std::string& username,
-                                         const std::string& password);
+                                         const std::string& password,
+                                         trace::SpanContext parent = {});
 
-        // 登出（使 Token 失效）
-        drogon::Task<bool> logout(int64_t userId, const std::string& token);
+        // 登出（吊销 Token，吊销记录在 Token 过期时随之过期）
+        drogon::Task<bool> logout(int64_t userId,
+                                  const std::string& tokenId,
+                                  std::chrono::system_clock::time_point expiresAt,
+                                  trace::SpanContext parent = {});
 
         // 刷新 Token
-        drogon::Task<LoginResult> refreshToken(int64_t userId);
+        drogon::Task<LoginResult> refreshToken(int64_t userId, trace::SpanContext parent = {});
 
-        // 验证 Token 是否在黑名单
-        drogon::Task<bool> isTokenBlacklisted(const std::string& token);
+        // 验证 Token 是否在黑名单（tokenId 见 JwtPayload::tokenId）
+        drogon::Task<bool> isTokenBlacklisted(const std::string& tokenId);
 
         // 修改密码
         drogon::Task<bool> changePassword(int64_t userId,
                                            const std::string& oldPassword,
-                                           const std::string& newPassword);
+                                           const std::string& newPassword,
+                                           trace::SpanContext parent = {});
 
     private:
         AuthService() = default;
         ~AuthService() = default;
         AuthService(const AuthService&) = delete;
         AuthService& operator=(const AuthService&) = delete;
-
-        // Token 黑名单 key
-        [[nodiscard]] std::string buildBlacklistKey(const std::string& token) const;
     };
 
 } // namespace services
\ No newline at end of file
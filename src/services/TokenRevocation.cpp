@@ -0,0 +1,143 @@
+#include "TokenRevocation.hpp"
+#include "utils/Redis.hpp"
+#include "core/Constants.hpp"
+#include "core/Exception.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace services {
+
+TokenRevocation& TokenRevocation::instance() {
+    static TokenRevocation instance;
+    return instance;
+}
+
+void TokenRevocation::setExpectedEntries(size_t entries) {
+    expectedEntries_ = entries;
+}
+
+std::string TokenRevocation::buildKey(const std::string& tokenId) const {
+    return std::string(core::constants::REDIS_TOKEN_BLACKLIST_PREFIX) + tokenId;
+}
+
+std::shared_ptr<utils::BloomFilter> TokenRevocation::newFilter() const {
+    auto entries = expectedEntries_ > 0 ? expectedEntries_
+                                        : core::constants::REVOCATION_EXPECTED_ENTRIES;
+    return std::make_shared<utils::BloomFilter>(
+        entries, core::constants::REVOCATION_FALSE_POSITIVE_RATE);
+}
+
+void TokenRevocation::start() {
+    // 先订阅再加载，避免加载期间的吊销被遗漏
+    try {
+        subscriber_ = utils::Redis::instance().subscribe(
+            core::constants::REDIS_TOKEN_REVOKED_CHANNEL,
+            [this](const std::string& tokenId) {
+                addLocal(tokenId);
+            });
+    } catch (const core::RedisException& e) {
+        spdlog::error("Failed to subscribe token revocations: {}", e.what());
+    }
+
+    drogon::async_run([this]() -> drogon::Task<void> {
+        co_await rebuild();
+    });
+
+    // 定期重建，清除已过期的条目，并兜底订阅断线期间漏掉的广播
+    auto interval = std::chrono::duration_cast<std::chrono::duration<double>>(
+        core::constants::REVOCATION_REBUILD_INTERVAL).count();
+    drogon::app().getLoop()->runEvery(interval, [this]() {
+        drogon::async_run([this]() -> drogon::Task<void> {
+            co_await rebuild();
+        });
+    });
+}
+
+drogon::Task<void> TokenRevocation::rebuild() {
+    auto fresh = newFilter();
+    pending_.store(fresh);
+
+    const std::string prefix = core::constants::REDIS_TOKEN_BLACKLIST_PREFIX;
+    size_t loaded = 0;
+    bool ok = true;
+
+    try {
+        auto keys = co_await utils::Redis::instance().scanKeys(prefix + "*");
+        for (const auto& key : keys) {
+            fresh->add(std::string_view(key).substr(prefix.size()));
+        }
+        loaded = keys.size();
+    } catch (const core::RedisException& e) {
+        spdlog::error("Failed to load token revocations: {}", e.what());
+        ok = false;
+    }
+
+    if (!ok) {
+        pending_.store(nullptr);
+        if (!ready_.load(std::memory_order_acquire)) {
+            spdlog::warn("Token revocation filter not ready, every authenticated request checks Redis");
+        }
+        scheduleRetry();
+        co_return;
+    }
+
+    // 先发布新过滤器再清除 pending_：与 addLocal 的读取顺序配合，期间的吊销不会只落在旧过滤器上
+    filter_.store(std::move(fresh));
+    pending_.store(nullptr);
+    failedAttempts_.store(0);
+    ready_.store(true, std::memory_order_release);
+    spdlog::info("Token revocation filter rebuilt: entries={}", loaded);
+}
+
+void TokenRevocation::scheduleRetry() {
+    if (retryScheduled_.exchange(true)) {
+        return;
+    }
+
+    const auto attempt = std::min<uint32_t>(failedAttempts_.fetch_add(1), 16);
+    const auto delay = std::min<std::chrono::seconds>(
+        core::constants::REVOCATION_RETRY_BASE * (int64_t{1} << attempt),
+        core::constants::REVOCATION_RETRY_MAX);
+    spdlog::warn("Token revocation reload retry in {}s", delay.count());
+
+    drogon::app().getLoop()->runAfter(static_cast<double>(delay.count()), [this]() {
+        retryScheduled_.store(false);
+        drogon::async_run([this]() -> drogon::Task<void> {
+            co_await rebuild();
+        });
+    });
+}
+
+void TokenRevocation::addLocal(std::string_view tokenId) {
+    // 先写 pending_ 再写 filter_：读到 pending_ 为空时，rebuild 已发布的新过滤器必然可见
+    if (auto pending = pending_.load()) {
+        pending->add(tokenId);
+    }
+    if (auto filter = filter_.load()) {
+        filter->add(tokenId);
+    }
+}
+
+bool TokenRevocation::mightBeRevoked(std::string_view tokenId) const {
+    if (!ready_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    auto filter = filter_.load();
+    return !filter || filter->mightContain(tokenId);
+}
+
+drogon::Task<void> TokenRevocation::revoke(const std::string& tokenId, std::chrono::seconds ttl,
+                                           trace::SpanContext parent) {
+    auto redis = utils::Redis::instance().traced(parent);
+    co_await redis.setEx(buildKey(tokenId), "1", ttl);
+
+    // 本节点立即生效，其他节点通过广播同步
+    addLocal(tokenId);
+    co_await redis.publish(core::constants::REDIS_TOKEN_REVOKED_CHANNEL, tokenId);
+}
+
+drogon::Task<bool> TokenRevocation::isRevoked(const std::string& tokenId) {
+    co_return co_await utils::Redis::instance().exists(buildKey(tokenId));
+}
+
+} // namespace services
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <drogon/drogon.h>
+#include <drogon/nosql/RedisClient.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "utils/BloomFilter.hpp"
+#include "trace/Span.hpp"
+
+namespace services {
+
+    // Token 吊销列表：进程内布隆过滤器 + Redis 权威存储
+    // 启动时全量加载，运行中通过 Redis 发布/订阅同步其他节点的吊销
+    // 过滤器未命中即可放行，只有命中时才需要查询 Redis
+    class TokenRevocation {
+    public:
+        // 单例获取
+        static TokenRevocation& instance();
+
+        // 配置（需在 start 之前调用）
+        void setExpectedEntries(size_t entries);
+
+        // 启动：订阅吊销广播、全量加载并定期重建（需在 Redis 可用后调用）
+        void start();
+
+        // 是否可能已吊销；过滤器尚未加载成功时返回 true，由调用方逐个查询 Redis
+        //（Redis 也不可用时调用方返回 503，不放行也不按已吊销处理）
+        [[nodiscard]] bool mightBeRevoked(std::string_view tokenId) const;
+
+        // 吊销 Token（写入 Redis 并广播）；tokenId 可为二进制，ttl 取 Token 剩余有效期
+        drogon::Task<void> revoke(const std::string& tokenId, std::chrono::seconds ttl,
+                                  trace::SpanContext parent = {});
+
+        // 查询 Redis 确认是否已吊销
+        drogon::Task<bool> isRevoked(const std::string& tokenId);
+
+    private:
+        TokenRevocation() = default;
+        ~TokenRevocation() = default;
+        TokenRevocation(const TokenRevocation&) = delete;
+        TokenRevocation& operator=(const TokenRevocation&) = delete;
+
+        // 从 Redis 重新加载，替换当前过滤器（清除已过期条目）
+        drogon::Task<void> rebuild();
+
+        // 加载失败后按指数退避重试（同一时刻最多一个待执行的重试）
+        void scheduleRetry();
+
+        // 写入本地过滤器（包括重建中的过滤器）
+        void addLocal(std::string_view tokenId);
+
+        [[nodiscard]] std::string buildKey(const std::string& tokenId) const;
+        [[nodiscard]] std::shared_ptr<utils::BloomFilter> newFilter() const;
+
+        std::atomic<std::shared_ptr<utils::BloomFilter>> filter_;
+        std::atomic<std::shared_ptr<utils::BloomFilter>> pending_;
+        std::shared_ptr<drogon::nosql::RedisSubscriber> subscriber_;
+        std::atomic<bool> ready_{false};
+        std::atomic<bool> retryScheduled_{false};
+        std::atomic<uint32_t> failedAttempts_{0};
+        size_t expectedEntries_{0};
+    };
+
+} // namespace services
\ No newline at end of file
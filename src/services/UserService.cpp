@@ -11,17 +11,18 @@ UserService& UserService::instance() {
     return instance;
 }
 
-drogon::Task<models::Users> UserService::getUserById(int64_t userId) {
+drogon::Task<models::Users> UserService::getUserById(int64_t userId, trace::SpanContext parent) {
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
-    co_return co_await mapper.findById(userId);
+    co_return co_await mapper.findById(userId, models::Projection::Api);
 }
 
 drogon::Task<models::PageResult> UserService::listUsers(int page, int pageSize,
-                                                         const std::string& keyword) {
+                                                         const std::string& keyword,
+                                                         trace::SpanContext parent) {
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
     auto result = co_await mapper.findPage(page, pageSize, keyword);
 
@@ -31,18 +32,34 @@ drogon::Task<models::PageResult> UserService::listUsers(int page, int pageSize,
     co_return result;
 }
 
+drogon::Task<models::CursorPageResult> UserService::listUsersAfter(const std::string& cursor,
+                                                                   int pageSize,
+                                                                   const std::string& keyword,
+                                                                   trace::SpanContext parent) {
+    auto dbClient = drogon::app().getDbClient();
+    models::UserMapper mapper(dbClient, parent);
+
+    auto result = co_await mapper.findPageAfter(cursor, pageSize, keyword);
+
+    spdlog::debug("Listed users after cursor: pageSize={}, count={}, hasMore={}",
+                  result.pageSize, result.list.size(), !result.nextCursor.empty());
+
+    co_return result;
+}
+
 drogon::Task<bool> UserService::updateUser(int64_t userId,
                                             const std::optional<std::string>& email,
-                                            const std::optional<std::string>& role) {
+                                            const std::optional<std::string>& role,
+                                            trace::SpanContext parent) {
     if (!email && !role) {
         throw core::ParamException("nothing to update");
     }
 
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
     // 检查用户是否存在
-    auto userOpt = co_await mapper.findByIdOptional(userId);
+    auto userOpt = co_await mapper.findByIdOptional(userId, models::Projection::Api);
     if (!userOpt) {
         throw core::NotFoundException("user not found: " + std::to_string(userId));
     }
@@ -62,16 +79,16 @@ drogon::Task<bool> UserService::updateUser(int64_t userId,
     co_return true;
 }
 
-drogon::Task<bool> UserService::setUserStatus(int64_t userId, int status) {
+drogon::Task<bool> UserService::setUserStatus(int64_t userId, int status, trace::SpanContext parent) {
     if (status != 0 && status != 1) {
         throw core::ParamException("status must be 0 or 1");
     }
 
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
     // 检查用户是否存在
-    auto userOpt = co_await mapper.findByIdOptional(userId);
+    auto userOpt = co_await mapper.findByIdOptional(userId, models::Projection::Api);
     if (!userOpt) {
         throw core::NotFoundException("user not found: " + std::to_string(userId));
     }
@@ -85,9 +102,9 @@ drogon::Task<bool> UserService::setUserStatus(int64_t userId, int status) {
     co_return true;
 }
 
-drogon::Task<bool> UserService::deleteUser(int64_t userId) {
+drogon::Task<bool> UserService::deleteUser(int64_t userId, trace::SpanContext parent) {
     auto dbClient = drogon::app().getDbClient();
-    models::UserMapper mapper(dbClient);
+    models::UserMapper mapper(dbClient, parent);
 
     bool deleted = co_await mapper.deleteById(userId);
     if (!deleted) {
@@ -7,6 +7,7 @@
 #include <json/json.h>
 #include "models/Users.hpp"
 #include "models/UserMapper.hpp"
+#include "trace/Span.hpp"
 
 namespace services {
 
@@ -16,23 +17,32 @@ namespace services {
         // 单例获取
         static UserService& instance();
 
+        // 以下接口的 parent 为调用方 Span 上下文，数据库访问记录为其子 Span
+
         // 获取用户信息
-        drogon::Task<models::Users> getUserById(int64_t userId);
+        drogon::Task<models::Users> getUserById(int64_t userId, trace::SpanContext parent = {});
 
         // 获取用户列表（分页）
         drogon::Task<models::PageResult> listUsers(int page, int pageSize,
-                                                    const std::string& keyword = "");
+                                                    const std::string& keyword = "",
+                                                    trace::SpanContext parent = {});
+
+        // 获取用户列表（游标分页，cursor 为空取第一页）
+        drogon::Task<models::CursorPageResult> listUsersAfter(const std::string& cursor, int pageSize,
+                                                              const std::string& keyword = "",
+                                                              trace::SpanContext parent = {});
 
         // 更新用户信息
         drogon::Task<bool> updateUser(int64_t userId,
                                        const std::optional<std::string>& email,
-                                       const std::optional<std::string>& role);
+                                       const std::optional<std::string>& role,
+                                       trace::SpanContext parent = {});
 
         // 禁用/启用用户
-        drogon::Task<bool> setUserStatus(int64_t userId, int status);
+        drogon::Task<bool> setUserStatus(int64_t userId, int status, trace::SpanContext parent = {});
 
         // 删除用户
-        drogon::Task<bool> deleteUser(int64_t userId);
+        drogon::Task<bool> deleteUser(int64_t userId, trace::SpanContext parent = {});
 
     private:
         UserService() = default;
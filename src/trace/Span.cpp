@@ -0,0 +1,211 @@
+#include "Span.hpp"
+#include "Tracer.hpp"
+#include "utils/Codec.hpp"
+#include "utils/Crypto.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace trace {
+
+namespace {
+
+    // 线程本地 ID 生成器（splitmix64，首次使用时由 CSPRNG 播种）
+    uint64_t nextRandom() {
+        thread_local uint64_t state = utils::Crypto::randomU64();
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    template <size_t N>
+    void fillRandom(std::array<uint8_t, N>& out) {
+        for (size_t i = 0; i < N; i += 8) {
+            uint64_t value = nextRandom();
+            // 全零 ID 非法
+            if (i == 0 && value == 0) {
+                value = 1;
+            }
+            std::memcpy(out.data() + i, &value, std::min<size_t>(8, N - i));
+        }
+    }
+
+    template <size_t N>
+    bool allZero(const std::array<uint8_t, N>& id) {
+        return std::all_of(id.begin(), id.end(), [](uint8_t b) { return b == 0; });
+    }
+
+    int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    template <size_t N>
+    bool parseHex(std::string_view text, std::array<uint8_t, N>& out) {
+        if (text.size() != N * 2) {
+            return false;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            int hi = hexValue(text[i * 2]);
+            int lo = hexValue(text[i * 2 + 1]);
+            if (hi < 0 || lo < 0) {
+                return false;
+            }
+            out[i] = static_cast<uint8_t>((hi << 4) | lo);
+        }
+        return true;
+    }
+
+    template <size_t N>
+    void appendHex(std::string& out, const std::array<uint8_t, N>& id) {
+        const auto pos = out.size();
+        out.resize(pos + N * 2);
+        utils::codec::hexEncode(id.data(), N, out.data() + pos);
+    }
+
+    int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+} // namespace
+
+// ==================== SpanContext ====================
+
+bool SpanContext::valid() const noexcept {
+    return !allZero(traceId) && !allZero(spanId);
+}
+
+std::optional<SpanContext> SpanContext::parse(std::string_view traceparent) {
+    // 00-<32 hex trace-id>-<16 hex parent-id>-<2 hex flags>
+    if (traceparent.size() != 55 || traceparent.substr(0, 3) != "00-" ||
+        traceparent[35] != '-' || traceparent[52] != '-') {
+        return std::nullopt;
+    }
+
+    SpanContext ctx;
+    std::array<uint8_t, 1> flags{};
+    if (!parseHex(traceparent.substr(3, 32), ctx.traceId) ||
+        !parseHex(traceparent.substr(36, 16), ctx.spanId) ||
+        !parseHex(traceparent.substr(53, 2), flags) ||
+        !ctx.valid()) {
+        return std::nullopt;
+    }
+    ctx.sampled = (flags[0] & 0x01) != 0;
+    return ctx;
+}
+
+std::string SpanContext::traceparent() const {
+    std::string out;
+    out.reserve(55);
+    out += "00-";
+    appendHex(out, traceId);
+    out += '-';
+    appendHex(out, spanId);
+    out += sampled ? "-01" : "-00";
+    return out;
+}
+
+// ==================== Span ====================
+
+Span::Span(std::string_view name, SpanKind kind, const SpanContext& parent) {
+    if (!parent.valid()) {
+        return;
+    }
+    context_.traceId = parent.traceId;
+    context_.sampled = parent.sampled;
+    record_.parentSpanId = parent.spanId;
+    begin(name, kind);
+}
+
+Span Span::root(std::string_view name, SpanKind kind, const std::optional<SpanContext>& remoteParent) {
+    Span span;
+    auto& tracer = Tracer::instance();
+    if (!tracer.enabled()) {
+        return span;
+    }
+
+    if (remoteParent) {
+        span.context_.traceId = remoteParent->traceId;
+        span.context_.sampled = remoteParent->sampled;
+        span.record_.parentSpanId = remoteParent->spanId;
+    } else {
+        fillRandom(span.context_.traceId);
+        span.context_.sampled = tracer.sampleRoot();
+    }
+    span.begin(name, kind);
+    return span;
+}
+
+void Span::begin(std::string_view name, SpanKind kind) {
+    fillRandom(context_.spanId);
+    recording_ = context_.sampled;
+    if (!recording_) {
+        return;
+    }
+
+    record_.traceId = context_.traceId;
+    record_.spanId = context_.spanId;
+    record_.kind = kind;
+    record_.startNs = nowNs();
+    auto len = std::min(name.size(), sizeof(record_.name) - 1);
+    std::memcpy(record_.name, name.data(), len);
+    record_.name[len] = '\0';
+}
+
+Span::~Span() {
+    end();
+}
+
+Span::Span(Span&& other) noexcept
+    : context_(other.context_)
+    , recording_(other.recording_)
+    , record_(other.record_) {
+    other.recording_ = false;
+}
+
+Span& Span::operator=(Span&& other) noexcept {
+    if (this != &other) {
+        end();
+        context_ = other.context_;
+        recording_ = other.recording_;
+        record_ = other.record_;
+        other.recording_ = false;
+    }
+    return *this;
+}
+
+void Span::setAttribute(const char* key, std::string_view value) {
+    if (!recording_ || record_.attributeCount >= SpanRecord::MAX_ATTRIBUTES) {
+        return;
+    }
+    auto& attr = record_.attributes[record_.attributeCount++];
+    attr.key = key;
+    auto len = std::min(value.size(), sizeof(attr.value) - 1);
+    std::memcpy(attr.value, value.data(), len);
+    attr.value[len] = '\0';
+}
+
+void Span::setError() {
+    if (recording_) {
+        record_.error = true;
+    }
+}
+
+void Span::end() {
+    if (!recording_) {
+        return;
+    }
+    recording_ = false;
+    record_.endNs = nowNs();
+    Tracer::instance().submit(record_);
+}
+
+SpanContext contextOf(const drogon::HttpRequestPtr& req) {
+    auto span = Tracer::requestSpan(req);
+    return span ? span->context() : SpanContext{};
+}
+
+} // namespace trace
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <drogon/HttpRequest.h>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace trace {
+
+    using TraceId = std::array<uint8_t, 16>;
+    using SpanId = std::array<uint8_t, 8>;
+
+    // W3C Trace Context（traceparent）
+    struct SpanContext {
+        TraceId traceId{};
+        SpanId spanId{};
+        bool sampled{false};
+
+        [[nodiscard]] bool valid() const noexcept;
+
+        // 解析 traceparent 头（version 00），格式错误返回 nullopt
+        static std::optional<SpanContext> parse(std::string_view traceparent);
+
+        // 生成 traceparent 头
+        [[nodiscard]] std::string traceparent() const;
+    };
+
+    // OTLP SpanKind 取值
+    enum class SpanKind : uint8_t {
+        Internal = 1,
+        Server = 2,
+        Client = 3,
+        Producer = 4,
+        Consumer = 5,
+    };
+
+    // 已结束 Span 的定长记录（写入环形缓冲区时无需分配；超长字段截断）
+    struct SpanRecord {
+        static constexpr size_t MAX_ATTRIBUTES = 2;
+
+        struct Attribute {
+            const char* key{nullptr};  // 须为静态字符串
+            char value[160]{};
+        };
+
+        TraceId traceId{};
+        SpanId spanId{};
+        SpanId parentSpanId{};
+        int64_t startNs{0};
+        int64_t endNs{0};
+        SpanKind kind{SpanKind::Internal};
+        bool error{false};
+        char name[64]{};
+        std::array<Attribute, MAX_ATTRIBUTES> attributes{};
+        uint8_t attributeCount{0};
+    };
+
+    // Span（RAII，析构时结束）
+    // 上下文显式传递：子 Span 以父 Span 的 context() 构造，跨协程 / 跨进程同样适用
+    // 未采样时仍生成有效上下文用于传播，但不记录
+    class Span {
+    public:
+        Span() = default;
+
+        // 子 Span；父上下文无效（未启用追踪或调用方未传入）时为空 Span
+        Span(std::string_view name, SpanKind kind, const SpanContext& parent);
+
+        // 根 Span：有远端父上下文时沿用其 traceId 与采样标志，否则新建 trace 并按采样率决定
+        static Span root(std::string_view name, SpanKind kind,
+                         const std::optional<SpanContext>& remoteParent);
+
+        ~Span();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+        Span(Span&& other) noexcept;
+        Span& operator=(Span&& other) noexcept;
+
+        [[nodiscard]] const SpanContext& context() const noexcept { return context_; }
+        [[nodiscard]] bool recording() const noexcept { return recording_; }
+
+        // 附加属性（超出 SpanRecord::MAX_ATTRIBUTES 的忽略）
+        void setAttribute(const char* key, std::string_view value);
+        void setError();
+
+        // 结束并提交（重复调用无效果）
+        void end();
+
+    private:
+        void begin(std::string_view name, SpanKind kind);
+
+        SpanContext context_;
+        bool recording_{false};
+        SpanRecord record_;
+    };
+
+    // 请求的服务端 Span 上下文（由 LogFilter 创建）；未追踪时返回无效上下文
+    SpanContext contextOf(const drogon::HttpRequestPtr& req);
+
+} // namespace trace
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "Tracer.hpp"
+#include "utils/Codec.hpp"
+#include "utils/FastPath.hpp"
+#include <drogon/drogon.h>
+#include <drogon/HttpClient.h>
+#include <trantor/net/EventLoopThread.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace trace {
+
+namespace {
+
+    const std::string SPAN_ATTRIBUTE_KEY = "traceSpan";
+
+    std::string toHex(const uint8_t* data, size_t size) {
+        std::string out(size * 2, '\0');
+        utils::codec::hexEncode(data, size, out.data());
+        return out;
+    }
+
+    Json::Value stringAttribute(const char* key, const char* value) {
+        Json::Value attr;
+        attr["key"] = key;
+        attr["value"]["stringValue"] = value;
+        return attr;
+    }
+
+} // namespace
+
+Tracer& Tracer::instance() {
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::~Tracer() {
+    stop();
+}
+
+void Tracer::configure(const Json::Value& config) {
+    enabled_ = config.get("enabled", false).asBool();
+    sampleRate_ = std::clamp(config.get("sample_rate", 1.0).asDouble(), 0.0, 1.0);
+    serviceName_ = config.get("service_name", serviceName_).asString();
+    exporter_ = config.get("exporter", exporter_).asString();
+    filePath_ = config.get("file", filePath_).asString();
+    endpoint_ = config.get("endpoint", endpoint_).asString();
+    ringCapacity_ = std::max<size_t>(64, config.get("ring_capacity", 8192).asUInt());
+    batchSize_ = std::max<size_t>(1, config.get("batch_size", 512).asUInt());
+    flushInterval_ = std::chrono::milliseconds(
+        std::max(1, config.get("flush_interval_ms", 1000).asInt()));
+}
+
+void Tracer::install() {
+    drogon::app().registerPostHandlingAdvice(
+        [](const drogon::HttpRequestPtr& req, const drogon::HttpResponsePtr& resp) {
+            auto span = requestSpan(req);
+            if (!span) {
+                return;
+            }
+            auto status = static_cast<int>(resp->statusCode());
+            span->setAttribute("http.response.status_code", std::to_string(status));
+            if (status >= 500) {
+                span->setError();
+            }
+            span->end();
+        });
+}
+
+void Tracer::start() {
+    if (!enabled_ || exporterThread_.joinable()) {
+        return;
+    }
+    exporterThread_ = std::jthread([this](std::stop_token stop) {
+        run(stop);
+    });
+    spdlog::info("Tracing started: exporter={}, sampleRate={}", exporter_, sampleRate_);
+}
+
+void Tracer::stop() {
+    if (!exporterThread_.joinable()) {
+        return;
+    }
+    exporterThread_.request_stop();
+    exporterThread_.join();
+}
+
+bool Tracer::sampleRoot() const {
+    return sampleRate_ >= 1.0 || utils::fastSample() < sampleRate_;
+}
+
+void Tracer::submit(const SpanRecord& record) {
+    if (!localRing().tryPush(record)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+Tracer::Ring& Tracer::localRing() {
+    thread_local Ring* ring = nullptr;
+    if (!ring) {
+        auto owned = std::make_shared<Ring>(ringCapacity_);
+        ring = owned.get();
+        std::lock_guard<std::mutex> lk(ringsMutex_);
+        rings_.push_back(std::move(owned));
+    }
+    return *ring;
+}
+
+void Tracer::attach(const drogon::HttpRequestPtr& req, std::shared_ptr<Span> span) {
+    req->getAttributes()->insert(SPAN_ATTRIBUTE_KEY, std::move(span));
+}
+
+std::shared_ptr<Span> Tracer::requestSpan(const drogon::HttpRequestPtr& req) {
+    return req->getAttributes()->get<std::shared_ptr<Span>>(SPAN_ATTRIBUTE_KEY);
+}
+
+void Tracer::run(std::stop_token stop) {
+    std::vector<SpanRecord> batch;
+    batch.reserve(batchSize_);
+    while (!stop.stop_requested()) {
+        if (drain(batch) < batchSize_) {
+            std::this_thread::sleep_for(flushInterval_);
+        }
+    }
+    // 退出前导出剩余 Span
+    while (drain(batch) > 0) {
+    }
+}
+
+size_t Tracer::drain(std::vector<SpanRecord>& batch) {
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lk(ringsMutex_);
+        rings = rings_;
+    }
+
+    batch.clear();
+    SpanRecord record;
+    for (const auto& ring : rings) {
+        while (batch.size() < batchSize_ && ring->tryPop(record)) {
+            batch.push_back(record);
+        }
+    }
+
+    if (!batch.empty()) {
+        exportBatch(batch);
+    }
+
+    auto dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reportedDropped_) {
+        spdlog::warn("Tracing dropped {} spans (total {})", dropped - reportedDropped_, dropped);
+        reportedDropped_ = dropped;
+    }
+    return batch.size();
+}
+
+std::string Tracer::toOtlpJson(const std::vector<SpanRecord>& batch) const {
+    Json::Value spans(Json::arrayValue);
+    for (const auto& record : batch) {
+        Json::Value span;
+        span["traceId"] = toHex(record.traceId.data(), record.traceId.size());
+        span["spanId"] = toHex(record.spanId.data(), record.spanId.size());
+        if (std::any_of(record.parentSpanId.begin(), record.parentSpanId.end(),
+                        [](uint8_t b) { return b != 0; })) {
+            span["parentSpanId"] = toHex(record.parentSpanId.data(), record.parentSpanId.size());
+        }
+        span["name"] = record.name;
+        span["kind"] = static_cast<int>(record.kind);
+        // OTLP JSON 中 64 位整数以字符串表示
+        span["startTimeUnixNano"] = std::to_string(record.startNs);
+        span["endTimeUnixNano"] = std::to_string(record.endNs);
+
+        Json::Value attributes(Json::arrayValue);
+        for (size_t i = 0; i < record.attributeCount; ++i) {
+            attributes.append(stringAttribute(record.attributes[i].key, record.attributes[i].value));
+        }
+        span["attributes"] = std::move(attributes);
+        if (record.error) {
+            span["status"]["code"] = 2;
+        }
+        spans.append(std::move(span));
+    }
+
+    Json::Value resourceSpans;
+    resourceSpans["resource"]["attributes"].append(
+        stringAttribute("service.name", serviceName_.c_str()));
+    Json::Value scopeSpans;
+    scopeSpans["scope"]["name"] = serviceName_;
+    scopeSpans["spans"] = std::move(spans);
+    resourceSpans["scopeSpans"].append(std::move(scopeSpans));
+
+    Json::Value root;
+    root["resourceSpans"].append(std::move(resourceSpans));
+
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    return Json::writeString(writer, root);
+}
+
+void Tracer::exportBatch(const std::vector<SpanRecord>& batch) {
+    auto payload = toOtlpJson(batch);
+
+    if (exporter_ == "otlp_http") {
+        // 客户端运行在独立事件循环上：主循环退出后 stop() 仍能同步导出剩余 Span
+        static trantor::EventLoopThread loopThread("TraceExporter");
+        static auto client = [this] {
+            loopThread.run();
+            return drogon::HttpClient::newHttpClient(endpoint_, loopThread.getLoop());
+        }();
+        auto req = drogon::HttpRequest::newHttpRequest();
+        req->setMethod(drogon::Post);
+        req->setPath("/v1/traces");
+        req->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+        req->setBody(std::move(payload));
+        auto [result, resp] = client->sendRequest(req, 5.0);
+        if (result != drogon::ReqResult::Ok || !resp || resp->statusCode() >= 300) {
+            spdlog::warn("Trace export failed: spans={}, result={}", batch.size(),
+                         static_cast<int>(result));
+        }
+        return;
+    }
+
+    auto dir = std::filesystem::path(filePath_).parent_path();
+    if (!dir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+    }
+    std::ofstream out(filePath_, std::ios::app);
+    if (!out) {
+        spdlog::warn("Trace export failed: cannot open {}", filePath_);
+        return;
+    }
+    out << payload << '\n';
+}
+
+} // namespace trace
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <drogon/HttpRequest.h>
+#include <json/json.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Span.hpp"
+#include "utils/SpscRing.hpp"
+
+namespace trace {
+
+    // Span 收集与导出
+    // 结束的 Span 以定长记录写入本线程的无锁环形缓冲区，后台线程按批组装 OTLP JSON
+    // 写入文件（每批一行）或 POST 到本地 collector（/v1/traces）；缓冲区满时丢弃并计数
+    class Tracer {
+    public:
+        // 单例获取
+        static Tracer& instance();
+
+        // 从 tracing 配置块加载（需在 start 之前调用）
+        void configure(const Json::Value& config);
+
+        // 注册处理后切面，结束请求的服务端 Span（需在 app().run() 之前调用）
+        void install();
+
+        // 启动 / 停止后台导出线程（停止时导出剩余 Span）
+        void start();
+        void stop();
+
+        [[nodiscard]] bool enabled() const noexcept { return enabled_; }
+
+        // 新 trace 的采样决定
+        [[nodiscard]] bool sampleRoot() const;
+
+        // 提交已结束的 Span（非阻塞）
+        void submit(const SpanRecord& record);
+
+        [[nodiscard]] uint64_t dropped() const noexcept {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+        // 请求的服务端 Span（存放在请求属性中）
+        static void attach(const drogon::HttpRequestPtr& req, std::shared_ptr<Span> span);
+        static std::shared_ptr<Span> requestSpan(const drogon::HttpRequestPtr& req);
+
+    private:
+        using Ring = utils::SpscRing<SpanRecord>;
+
+        Tracer() = default;
+        ~Tracer();
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        Ring& localRing();
+
+        void run(std::stop_token stop);
+        size_t drain(std::vector<SpanRecord>& batch);
+        void exportBatch(const std::vector<SpanRecord>& batch);
+        [[nodiscard]] std::string toOtlpJson(const std::vector<SpanRecord>& batch) const;
+
+        bool enabled_{false};
+        double sampleRate_{1.0};
+        std::string serviceName_{"drogon-starter"};
+        std::string exporter_{"file"};
+        std::string filePath_{"logs/traces.jsonl"};
+        std::string endpoint_{"http://127.0.0.1:4318"};
+        size_t ringCapacity_{8192};
+        size_t batchSize_{512};
+        std::chrono::milliseconds flushInterval_{1000};
+
+        std::mutex ringsMutex_;
+        std::vector<std::shared_ptr<Ring>> rings_;
+        std::atomic<uint64_t> dropped_{0};
+        uint64_t reportedDropped_{0};  // 仅后台线程访问
+        std::jthread exporterThread_;
+    };
+
+} // namespace trace
\ No newline at end of file
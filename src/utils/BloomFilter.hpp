@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace utils {
+
+    // 布隆过滤器（位数组使用原子操作，读写均无锁）
+    // 只会误报不会漏报，用于在访问 Redis 前快速排除
+    class BloomFilter {
+    public:
+        BloomFilter(size_t expectedItems, double falsePositiveRate) {
+            expectedItems = expectedItems > 0 ? expectedItems : 1;
+            const double ln2 = std::log(2.0);
+            auto bits = static_cast<size_t>(
+                -static_cast<double>(expectedItems) * std::log(falsePositiveRate) / (ln2 * ln2));
+            wordCount_ = (std::max<size_t>(bits, 64) + 63) / 64;
+            bitCount_ = wordCount_ * 64;
+            hashCount_ = std::max<uint32_t>(1, static_cast<uint32_t>(
+                std::round(static_cast<double>(bitCount_) / expectedItems * ln2)));
+            words_ = std::vector<std::atomic<uint64_t>>(wordCount_);
+        }
+
+        BloomFilter(const BloomFilter&) = delete;
+        BloomFilter& operator=(const BloomFilter&) = delete;
+
+        void add(std::string_view item) {
+            auto [h1, h2] = hashes(item);
+            for (uint32_t i = 0; i < hashCount_; ++i) {
+                const uint64_t bit = (h1 + i * h2) % bitCount_;
+                words_[bit / 64].fetch_or(uint64_t{1} << (bit % 64), std::memory_order_relaxed);
+            }
+        }
+
+        [[nodiscard]] bool mightContain(std::string_view item) const {
+            auto [h1, h2] = hashes(item);
+            for (uint32_t i = 0; i < hashCount_; ++i) {
+                const uint64_t bit = (h1 + i * h2) % bitCount_;
+                if (!(words_[bit / 64].load(std::memory_order_relaxed) & (uint64_t{1} << (bit % 64)))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        // 双重哈希：h1 取标准哈希，h2 由 splitmix64 派生（保证为奇数）
+        static std::pair<uint64_t, uint64_t> hashes(std::string_view item) {
+            uint64_t h1 = std::hash<std::string_view>{}(item);
+            uint64_t h2 = h1 + 0x9e3779b97f4a7c15ULL;
+            h2 = (h2 ^ (h2 >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            h2 = (h2 ^ (h2 >> 27)) * 0x94d049bb133111ebULL;
+            h2 ^= h2 >> 31;
+            return {h1, h2 | 1};
+        }
+
+        std::vector<std::atomic<uint64_t>> words_;
+        size_t wordCount_{0};
+        uint64_t bitCount_{0};
+        uint32_t hashCount_{1};
+    };
+
+} // namespace utils
\ No newline at end of file
@@ -0,0 +1,424 @@
+#include "Codec.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CODEC_X86 1
+#endif
+
+namespace utils::codec {
+
+namespace {
+
+    constexpr char STANDARD_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    constexpr char URL_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    constexpr char HEX_CHARS[] = "0123456789abcdef";
+
+    constexpr std::array<int8_t, 256> makeDecodeTable(const char* chars) {
+        std::array<int8_t, 256> table{};
+        for (auto& v : table) {
+            v = -1;
+        }
+        for (int i = 0; i < 64; ++i) {
+            table[static_cast<unsigned char>(chars[i])] = static_cast<int8_t>(i);
+        }
+        return table;
+    }
+
+    constexpr std::array<int8_t, 256> makeHexTable() {
+        std::array<int8_t, 256> table{};
+        for (auto& v : table) {
+            v = -1;
+        }
+        for (int i = 0; i < 10; ++i) {
+            table['0' + i] = static_cast<int8_t>(i);
+        }
+        for (int i = 0; i < 6; ++i) {
+            table['a' + i] = static_cast<int8_t>(10 + i);
+            table['A' + i] = static_cast<int8_t>(10 + i);
+        }
+        return table;
+    }
+
+    constexpr auto STANDARD_TABLE = makeDecodeTable(STANDARD_CHARS);
+    constexpr auto URL_TABLE = makeDecodeTable(URL_CHARS);
+    constexpr auto HEX_TABLE = makeHexTable();
+
+    // 向量化内核：处理尽可能多的整块，返回已消费的输入长度，剩余部分由标量代码完成
+    // encode：每 3 字节输入产出 4 字符；decode：每 4 字符产出 3 字节（遇到非法块即停止）
+    using EncodeKernel = size_t (*)(const uint8_t* in, size_t size, char* out, bool url);
+    using DecodeKernel = size_t (*)(const char* in, size_t size, uint8_t* out, size_t capacity, bool url);
+    using HexKernel = size_t (*)(const uint8_t* in, size_t size, char* out);
+
+    size_t encodeNone(const uint8_t*, size_t, char*, bool) { return 0; }
+    size_t decodeNone(const char*, size_t, uint8_t*, size_t, bool) { return 0; }
+    size_t hexNone(const uint8_t*, size_t, char*) { return 0; }
+
+#ifdef CODEC_X86
+
+    // ---------- SSSE3 ----------
+    // 算法见 Wojciech Muła, "Base64 encoding/decoding with SIMD instructions"
+
+    __attribute__((target("ssse3")))
+    inline __m128i encodeLookup128(__m128i indices, __m128i shiftLut) {
+        __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+        return _mm_add_epi8(_mm_shuffle_epi8(shiftLut, result), indices);
+    }
+
+    __attribute__((target("ssse3")))
+    inline __m128i encodeShiftLut128(bool url) {
+        return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                             url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+    }
+
+    __attribute__((target("ssse3")))
+    size_t encodeSsse3(const uint8_t* in, size_t size, char* out, bool url) {
+        const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+        const __m128i shiftLut = encodeShiftLut128(url);
+
+        size_t i = 0;
+        // 每次读 16 字节、使用 12 字节
+        for (; i + 16 <= size; i += 12) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            v = _mm_shuffle_epi8(v, shuffle);
+            const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+                                               _mm_set1_epi32(0x04000040));
+            const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+                                               _mm_set1_epi32(0x01000010));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 3 * 4),
+                             encodeLookup128(_mm_or_si128(t0, t1), shiftLut));
+        }
+        return i;
+    }
+
+    // 16 个字符翻译为 6 位值；含非法字符返回 false
+    __attribute__((target("ssse3")))
+    inline bool decodeTranslate128(__m128i& v, bool url) {
+        if (url) {
+            // 先把 '-' '_' 映射到 '+' '/'，原本的 '+' '/' 视为非法
+            const __m128i bad = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('+')),
+                                             _mm_cmpeq_epi8(v, _mm_set1_epi8('/')));
+            if (_mm_movemask_epi8(bad)) {
+                return false;
+            }
+            v = _mm_add_epi8(v, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('-')),
+                                              _mm_set1_epi8('+' - '-')));
+            v = _mm_add_epi8(v, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('_')),
+                                              _mm_set1_epi8('/' - '_')));
+        }
+
+        const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                              0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+
+        const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(v, 4), nibble);
+        const __m128i loNibbles = _mm_and_si128(v, nibble);
+        const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128()))) {
+            return false;
+        }
+
+        const __m128i eq2F = _mm_cmpeq_epi8(v, _mm_set1_epi8(0x2F));
+        v = _mm_add_epi8(v, _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles)));
+        return true;
+    }
+
+    // 6 位值打包为 12 字节（位于低 12 字节）
+    __attribute__((target("ssse3")))
+    inline __m128i decodePack128(__m128i v) {
+        const __m128i merged = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+        const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        return _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                                      -1, -1, -1, -1));
+    }
+
+    __attribute__((target("ssse3")))
+    size_t decodeSsse3(const char* in, size_t size, uint8_t* out, size_t capacity, bool url) {
+        size_t i = 0;
+        size_t o = 0;
+        // 每块写 16 字节（有效 12 字节），需为多写的 4 字节预留空间
+        for (; i + 16 <= size && o + 16 <= capacity; i += 16, o += 12) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            if (!decodeTranslate128(v, url)) {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), decodePack128(v));
+        }
+        return i;
+    }
+
+    __attribute__((target("ssse3")))
+    size_t hexSsse3(const uint8_t* in, size_t size, char* out) {
+        const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_CHARS));
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+            const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, nibble));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+        }
+        return i;
+    }
+
+    // ---------- AVX2 ----------
+    // 与 SSSE3 相同的算法，每个 128 位通道独立处理一块
+
+    __attribute__((target("avx2")))
+    size_t encodeAvx2(const uint8_t* in, size_t size, char* out, bool url) {
+        const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        const __m256i shiftLut = _mm256_broadcastsi128_si256(encodeShiftLut128(url));
+
+        size_t i = 0;
+        // 两个通道分别读 [i, i+16) 与 [i+12, i+28)，共使用 24 字节
+        for (; i + 28 <= size; i += 24) {
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+            __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+            v = _mm256_shuffle_epi8(v, shuffle);
+            const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)),
+                                                  _mm256_set1_epi32(0x04000040));
+            const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)),
+                                                  _mm256_set1_epi32(0x01000010));
+            const __m256i indices = _mm256_or_si256(t0, t1);
+
+            __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+            result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+            result = _mm256_add_epi8(_mm256_shuffle_epi8(shiftLut, result), indices);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 3 * 4), result);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    size_t decodeAvx2(const char* in, size_t size, uint8_t* out, size_t capacity, bool url) {
+        const __m256i lutLo = _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m256i lutHi = _mm256_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i lutRoll = _mm256_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i pack = _mm256_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+        size_t i = 0;
+        size_t o = 0;
+        // 高通道结果写在 o+12 处并多写 4 字节
+        for (; i + 32 <= size && o + 28 <= capacity; i += 32, o += 24) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            if (url) {
+                const __m256i bad = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('+')),
+                                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')));
+                if (_mm256_movemask_epi8(bad)) {
+                    break;
+                }
+                v = _mm256_add_epi8(v, _mm256_and_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('-')),
+                                                        _mm256_set1_epi8('+' - '-')));
+                v = _mm256_add_epi8(v, _mm256_and_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')),
+                                                        _mm256_set1_epi8('/' - '_')));
+            }
+
+            const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), nibble);
+            const __m256i loNibbles = _mm256_and_si256(v, nibble);
+            const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+            const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+            if (!_mm256_testz_si256(lo, hi)) {
+                break;
+            }
+
+            const __m256i eq2F = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x2F));
+            v = _mm256_add_epi8(v, _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles)));
+
+            const __m256i merged = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+            const __m256i packed = _mm256_shuffle_epi8(
+                _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000)), pack);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm256_castsi256_si128(packed));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o + 12), _mm256_extracti128_si256(packed, 1));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    size_t hexAvx2(const uint8_t* in, size_t size, char* out) {
+        const __m256i lut = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_CHARS)));
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+            const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, nibble));
+            // unpack 在通道内交错，再按通道重排回输入顺序
+            const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+            const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+        }
+        return i;
+    }
+
+#endif // CODEC_X86
+
+    struct Kernels {
+        EncodeKernel encode{encodeNone};
+        DecodeKernel decode{decodeNone};
+        HexKernel hex{hexNone};
+        const char* name{"scalar"};
+    };
+
+    Kernels selectKernels() {
+#ifdef CODEC_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Kernels{encodeAvx2, decodeAvx2, hexAvx2, "avx2"};
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+            return Kernels{encodeSsse3, decodeSsse3, hexSsse3, "ssse3"};
+        }
+#endif
+        return Kernels{};
+    }
+
+    const Kernels& kernels() {
+        static const Kernels selected = selectKernels();
+        return selected;
+    }
+
+} // namespace
+
+size_t base64Encode(const void* data, size_t size, char* out, Base64Alphabet alphabet, bool padded) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    const bool url = alphabet == Base64Alphabet::Url;
+    const char* chars = url ? URL_CHARS : STANDARD_CHARS;
+
+    size_t i = kernels().encode(in, size, out, url);
+    char* o = out + i / 3 * 4;
+
+    for (; i + 3 <= size; i += 3) {
+        const uint32_t n = (uint32_t(in[i]) << 16) | (uint32_t(in[i + 1]) << 8) | in[i + 2];
+        o[0] = chars[n >> 18];
+        o[1] = chars[(n >> 12) & 0x3F];
+        o[2] = chars[(n >> 6) & 0x3F];
+        o[3] = chars[n & 0x3F];
+        o += 4;
+    }
+
+    const size_t rest = size - i;
+    if (rest > 0) {
+        const uint32_t n = (uint32_t(in[i]) << 16) | (rest == 2 ? uint32_t(in[i + 1]) << 8 : 0);
+        *o++ = chars[n >> 18];
+        *o++ = chars[(n >> 12) & 0x3F];
+        if (rest == 2) {
+            *o++ = chars[(n >> 6) & 0x3F];
+        }
+        if (padded) {
+            *o++ = '=';
+            if (rest == 1) {
+                *o++ = '=';
+            }
+        }
+    }
+    return static_cast<size_t>(o - out);
+}
+
+std::optional<size_t> base64Decode(std::string_view input, void* out, size_t capacity,
+                                   Base64Alphabet alphabet) {
+    const bool url = alphabet == Base64Alphabet::Url;
+    // 标准字母表允许末尾 '=' 填充（须补齐到 4 的倍数）
+    if (!url && !input.empty() && input.back() == '=') {
+        if (input.size() % 4 != 0) {
+            return std::nullopt;
+        }
+        input.remove_suffix(input.size() >= 2 && input[input.size() - 2] == '=' ? 2 : 1);
+    }
+    if (input.size() % 4 == 1 || base64DecodedMaxLength(input.size()) > capacity) {
+        return std::nullopt;
+    }
+
+    const auto& table = url ? URL_TABLE : STANDARD_TABLE;
+    auto* o = static_cast<uint8_t*>(out);
+
+    size_t i = kernels().decode(input.data(), input.size(), o, capacity, url);
+    o += i / 4 * 3;
+
+    for (; i + 4 <= input.size(); i += 4) {
+        const int a = table[static_cast<unsigned char>(input[i])];
+        const int b = table[static_cast<unsigned char>(input[i + 1])];
+        const int c = table[static_cast<unsigned char>(input[i + 2])];
+        const int d = table[static_cast<unsigned char>(input[i + 3])];
+        if ((a | b | c | d) < 0) {
+            return std::nullopt;
+        }
+        const uint32_t n = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | uint32_t(d);
+        o[0] = static_cast<uint8_t>(n >> 16);
+        o[1] = static_cast<uint8_t>(n >> 8);
+        o[2] = static_cast<uint8_t>(n);
+        o += 3;
+    }
+
+    const size_t rest = input.size() - i;
+    if (rest >= 2) {
+        const int a = table[static_cast<unsigned char>(input[i])];
+        const int b = table[static_cast<unsigned char>(input[i + 1])];
+        const int c = rest == 3 ? table[static_cast<unsigned char>(input[i + 2])] : 0;
+        if ((a | b | c) < 0) {
+            return std::nullopt;
+        }
+        const uint32_t n = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6);
+        *o++ = static_cast<uint8_t>(n >> 16);
+        if (rest == 3) {
+            *o++ = static_cast<uint8_t>(n >> 8);
+        }
+    }
+    return static_cast<size_t>(o - static_cast<uint8_t*>(out));
+}
+
+void hexEncode(const void* data, size_t size, char* out) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    size_t i = kernels().hex(in, size, out);
+    for (; i < size; ++i) {
+        out[i * 2] = HEX_CHARS[in[i] >> 4];
+        out[i * 2 + 1] = HEX_CHARS[in[i] & 0xF];
+    }
+}
+
+bool hexDecode(std::string_view input, void* out) {
+    if (input.size() % 2 != 0) {
+        return false;
+    }
+    auto* o = static_cast<uint8_t*>(out);
+    for (size_t i = 0; i < input.size(); i += 2) {
+        const int hi = HEX_TABLE[static_cast<unsigned char>(input[i])];
+        const int lo = HEX_TABLE[static_cast<unsigned char>(input[i + 1])];
+        if ((hi | lo) < 0) {
+            return false;
+        }
+        o[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+const char* implementation() {
+    return kernels().name;
+}
+
+} // namespace utils::codec
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace utils::codec {
+
+    // base64 / base64url / hex 编解码（写入调用方缓冲区，不分配内存）
+    // x86 上运行时按 CPU 选择 AVX2 / SSSE3 实现，其余平台及尾部数据走标量实现
+
+    enum class Base64Alphabet : uint8_t {
+        Standard,  // A-Z a-z 0-9 + /，可带 '=' 填充
+        Url,       // A-Z a-z 0-9 - _，不带填充（JWT、游标等）
+    };
+
+    // 编码后长度
+    constexpr size_t base64EncodedLength(size_t size, bool padded) {
+        return padded ? (size + 2) / 3 * 4 : size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+    }
+
+    // 解码后最大长度（按无填充计算，实际长度由 base64Decode 返回）
+    constexpr size_t base64DecodedMaxLength(size_t length) {
+        return length / 4 * 3 + (length % 4 > 1 ? length % 4 - 1 : 0);
+    }
+
+    // 编码，返回写入的字符数（即 base64EncodedLength）
+    size_t base64Encode(const void* data, size_t size, char* out,
+                        Base64Alphabet alphabet = Base64Alphabet::Standard, bool padded = true);
+
+    // 解码，返回写入的字节数；非法字符、非法长度或 capacity 不足时返回 nullopt
+    // 末组多余的低位不做校验（与常见实现一致）
+    std::optional<size_t> base64Decode(std::string_view input, void* out, size_t capacity,
+                                       Base64Alphabet alphabet = Base64Alphabet::Standard);
+
+    // 小写十六进制编码，写入 size * 2 个字符
+    void hexEncode(const void* data, size_t size, char* out);
+
+    // 十六进制解码（大小写均可），写入 input.size() / 2 个字节；奇数长度或非法字符返回 false
+    bool hexDecode(std::string_view input, void* out);
+
+    // 当前使用的实现（"avx2" / "ssse3" / "scalar"）
+    const char* implementation();
+
+} // namespace utils::codec
@@ -1,8 +1,19 @@
 #pragma once
 
 #include <drogon/utils/Utilities.h>
+#include "Codec.hpp"
+#include <pthread.h>
+#include <sys/random.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
 #include <string>
-#include <random>
+#include <string_view>
 
 namespace utils {
 
@@ -18,17 +29,44 @@ namespace utils {
             return drogon::utils::getSha256(input);
         }
 
-        // Base64 编码
-        static std::string base64Encode(const std::string& input) {
-            return drogon::utils::base64Encode(
-                reinterpret_cast<const unsigned char*>(input.data()),
-                input.size()
-            );
+        // Base64 编码（SIMD 实现见 Codec.hpp，热路径可直接写入调用方缓冲区）
+        static std::string base64Encode(std::string_view input) {
+            std::string out(codec::base64EncodedLength(input.size(), true), '\0');
+            codec::base64Encode(input.data(), input.size(), out.data());
+            return out;
         }
 
-        // Base64 解码
-        static std::string base64Decode(const std::string& input) {
-            return drogon::utils::base64Decode(input);
+        // Base64 解码（输入非法时返回空串）
+        static std::string base64Decode(std::string_view input) {
+            std::string out(codec::base64DecodedMaxLength(input.size()), '\0');
+            auto len = codec::base64Decode(input, out.data(), out.size());
+            out.resize(len.value_or(0));
+            return out;
+        }
+
+        // Base64url 编码（不带填充）
+        static std::string base64UrlEncode(std::string_view input) {
+            std::string out(codec::base64EncodedLength(input.size(), false), '\0');
+            codec::base64Encode(input.data(), input.size(), out.data(), codec::Base64Alphabet::Url, false);
+            return out;
+        }
+
+        // Base64url 解码（输入非法时返回 nullopt）
+        static std::optional<std::string> base64UrlDecode(std::string_view input) {
+            std::string out(codec::base64DecodedMaxLength(input.size()), '\0');
+            auto len = codec::base64Decode(input, out.data(), out.size(), codec::Base64Alphabet::Url);
+            if (!len) {
+                return std::nullopt;
+            }
+            out.resize(*len);
+            return out;
+        }
+
+        // 小写十六进制编码
+        static std::string hexEncode(std::string_view input) {
+            std::string out(input.size() * 2, '\0');
+            codec::hexEncode(input.data(), input.size(), out.data());
+            return out;
         }
 
         // 生成 UUID
@@ -36,40 +74,172 @@ namespace utils {
             return drogon::utils::getUuid();
         }
 
-        // 生成随机字符串
+        // 生成 UUIDv7（按时间排序）
+        // 48 位毫秒时间戳 + 12 位线程内序号 + 62 位线程节点 ID（线程首次调用时随机生成）
+        // 热路径只读时钟（vDSO）并递增线程本地计数，无系统调用与共享状态
+        static std::string uuidV7() {
+            struct State {
+                uint64_t lastMs{0};
+                uint32_t seq{0};
+                uint64_t node{0};
+            };
+            thread_local State state = [] {
+                State s;
+                s.node = randomU64() & 0x3FFFFFFFFFFFFFFFULL;
+                return s;
+            }();
+
+            auto nowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+            if (nowMs > state.lastMs) {
+                state.lastMs = nowMs;
+                state.seq = 0;
+            } else if (++state.seq > 0xFFF) {
+                // 同一毫秒内序号用尽（或时钟回拨），借用下一毫秒保持单调
+                ++state.lastMs;
+                state.seq = 0;
+            }
+
+            const uint64_t hi = (state.lastMs << 16) | 0x7000ULL | state.seq;
+            const uint64_t lo = 0x8000000000000000ULL | state.node;
+
+            static constexpr char hex[] = "0123456789abcdef";
+            std::string out(36, '-');
+            size_t pos = 0;
+            auto put = [&out, &pos](uint64_t value, int nibbles) {
+                for (int i = nibbles - 1; i >= 0; --i) {
+                    if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+                        ++pos;
+                    }
+                    out[pos++] = hex[(value >> (i * 4)) & 0xF];
+                }
+            };
+            put(hi, 16);
+            put(lo, 16);
+            return out;
+        }
+
+        // 生成随机字符串（[0-9A-Za-z]，CSPRNG）
+        // 每字节取低 6 位查 64 项表，落在表尾 2 个空位的字节丢弃重抽（拒绝采样，无取模偏差）
         static std::string randomString(size_t length) {
-            static const char charset[] =
+            static constexpr char charset[64] =
                 "0123456789"
                 "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
                 "abcdefghijklmnopqrstuvwxyz";
+            static constexpr unsigned char CHARSET_SIZE = 62;
 
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_int_distribution<> dist(0, sizeof(charset) - 2);
-
-            std::string result;
-            result.reserve(length);
-            for (size_t i = 0; i < length; ++i) {
-                result += charset[dist(gen)];
+            std::string result(length, '\0');
+            unsigned char block[64];
+            size_t filled = 0;
+            while (filled < length) {
+                // 按期望接受率 62/64 多取一点，通常一轮即可填满
+                const size_t want = std::min(sizeof(block), (length - filled) + (length - filled) / 16 + 2);
+                fillRandom(block, want);
+                for (size_t i = 0; i < want && filled < length; ++i) {
+                    const unsigned char index = block[i] & 0x3F;
+                    if (index < CHARSET_SIZE) {
+                        result[filled++] = charset[index];
+                    }
+                }
             }
             return result;
         }
 
-        // 密码哈希（加盐）
-        static std::string hashPassword(const std::string& password, const std::string& salt) {
-            return sha256(salt + password + salt);
+        // 随机 64 位整数（CSPRNG）
+        static uint64_t randomU64() {
+            uint64_t value = 0;
+            fillRandom(&value, sizeof(value));
+            return value;
+        }
+
+        // 生成随机字节（CSPRNG）
+        static std::string randomBytes(size_t length) {
+            std::string result(length, '\0');
+            fillRandom(result.data(), length);
+            return result;
+        }
+
+        // 填充随机字节：线程本地缓冲，每次从 getrandom 批量取 4KB，热路径只做 memcpy
+        // fork 后子进程丢弃继承的缓冲，避免父子进程产出相同的随机数
+        static void fillRandom(void* dst, size_t length) {
+            struct Buffer {
+                unsigned char bytes[4096];
+                size_t pos{sizeof(bytes)};
+                unsigned generation{0};
+            };
+            thread_local Buffer buffer;
+
+            auto* out = static_cast<unsigned char*>(dst);
+            if (length >= sizeof(buffer.bytes) / 2) {
+                readSystemRandom(out, length);
+                return;
+            }
+
+            const unsigned generation = forkGeneration().load(std::memory_order_relaxed);
+            if (buffer.generation != generation) {
+                buffer.generation = generation;
+                buffer.pos = sizeof(buffer.bytes);
+            }
+
+            while (length > 0) {
+                if (buffer.pos == sizeof(buffer.bytes)) {
+                    readSystemRandom(buffer.bytes, sizeof(buffer.bytes));
+                    buffer.pos = 0;
+                }
+                const size_t n = std::min(length, sizeof(buffer.bytes) - buffer.pos);
+                std::memcpy(out, buffer.bytes + buffer.pos, n);
+                // 取出的字节立即清零，缓冲中不残留已交付的随机数
+                std::memset(buffer.bytes + buffer.pos, 0, n);
+                buffer.pos += n;
+                out += n;
+                length -= n;
+            }
         }
 
-        // 生成盐值
+        // 生成盐值（密码哈希见 PasswordHasher）
         static std::string generateSalt() {
             return randomString(32);
         }
 
-        // 验证密码
-        static bool verifyPassword(const std::string& password,
-                                   const std::string& salt,
-                                   const std::string& hash) {
-            return hashPassword(password, salt) == hash;
+        // 常量时间比较（Token / 摘要比较，避免时序侧信道）
+        static bool constantTimeEquals(std::string_view a, std::string_view b) {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            unsigned char diff = 0;
+            for (size_t i = 0; i < a.size(); ++i) {
+                diff |= static_cast<unsigned char>(a[i] ^ b[i]);
+            }
+            return diff == 0;
+        }
+
+    private:
+        // 从内核 CSPRNG 读取（阻塞直到熵池初始化，EINTR 时重试）
+        static void readSystemRandom(unsigned char* dst, size_t length) {
+            while (length > 0) {
+                const ssize_t n = ::getrandom(dst, length, 0);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::runtime_error("getrandom failed");
+                }
+                dst += n;
+                length -= static_cast<size_t>(n);
+            }
+        }
+
+        // fork 代数：子进程中递增，使各线程的随机缓冲失效
+        static std::atomic<unsigned>& forkGeneration() {
+            static std::atomic<unsigned> generation{0};
+            static const bool registered = [] {
+                ::pthread_atfork(nullptr, nullptr, [] {
+                    generation.fetch_add(1, std::memory_order_relaxed);
+                });
+                return true;
+            }();
+            (void)registered;
+            return generation;
         }
     };
 
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <drogon/drogon.h>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace utils {
+
+    // 立即启动的协程结果：start() 时协程已开始执行，稍后 co_await 取结果
+    // 用于让相互独立的 IO（如 COUNT 与列表查询）并发进行；结果可能在其他线程产生，
+    // 等待方总是回到自己所在的事件循环恢复
+    template <typename T>
+    class Deferred {
+    public:
+        // factory 返回 drogon::Task<T>，其捕获的对象在协程结束前保持有效
+        template <typename F>
+        static Deferred start(F factory) {
+            Deferred deferred;
+            drogon::async_run([state = deferred.state_, factory = std::move(factory)]() mutable
+                              -> drogon::Task<void> {
+                try {
+                    state->complete(co_await factory(), nullptr);
+                } catch (...) {
+                    state->complete(std::nullopt, std::current_exception());
+                }
+            });
+            return deferred;
+        }
+
+        auto operator co_await() {
+            struct Awaiter {
+                std::shared_ptr<State> state;
+
+                bool await_ready() const {
+                    std::lock_guard<std::mutex> lk(state->mutex);
+                    return state->done;
+                }
+
+                bool await_suspend(std::coroutine_handle<> handle) {
+                    auto* loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+                    std::lock_guard<std::mutex> lk(state->mutex);
+                    if (state->done) {
+                        return false;
+                    }
+                    state->waiter = handle;
+                    state->loop = loop ? loop : drogon::app().getLoop();
+                    return true;
+                }
+
+                T await_resume() {
+                    if (state->error) {
+                        std::rethrow_exception(state->error);
+                    }
+                    return std::move(*state->result);
+                }
+            };
+            return Awaiter{state_};
+        }
+
+    private:
+        struct State {
+            std::mutex mutex;
+            bool done{false};
+            std::optional<T> result;
+            std::exception_ptr error;
+            std::coroutine_handle<> waiter;
+            trantor::EventLoop* loop{nullptr};
+
+            void complete(std::optional<T> value, std::exception_ptr err) {
+                std::coroutine_handle<> handle;
+                trantor::EventLoop* target = nullptr;
+                {
+                    std::lock_guard<std::mutex> lk(mutex);
+                    result = std::move(value);
+                    error = err;
+                    done = true;
+                    handle = std::exchange(waiter, nullptr);
+                    target = loop;
+                }
+                if (handle) {
+                    target->queueInLoop([handle]() { handle.resume(); });
+                }
+            }
+        };
+
+        Deferred()
+            : state_(std::make_shared<State>()) {
+        }
+
+        std::shared_ptr<State> state_;
+    };
+
+} // namespace utils
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <thread>
+
+namespace utils {
+
+    // 透明字符串哈希：配合 std::equal_to<> 使 unordered_map<std::string, ...> 可直接用 string_view 查找，
+    // 热路径上不必为查找键构造临时 std::string
+    struct TransparentStringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view value) const noexcept {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    // 线程本地的快速随机数（xorshift64，返回 [0, 1)），仅用于采样等非安全场景
+    inline double fastSample() noexcept {
+        thread_local uint64_t state =
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<double>(state >> 11) * 0x1.0p-53;
+    }
+
+} // namespace utils
@@ -0,0 +1,137 @@
+#include "PasswordHasher.hpp"
+#include "Crypto.hpp"
+#include <openssl/evp.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <charconv>
+#include <thread>
+
+namespace utils {
+
+namespace {
+
+    constexpr std::string_view SCRYPT_PREFIX = "$scrypt$";
+    constexpr size_t DIGEST_BYTES = 32;
+
+    // 存储值中允许的参数范围（防止异常记录把单次计算拖到秒级或耗尽内存）
+    constexpr uint32_t MIN_LOG_N = 10, MAX_LOG_N = 22;
+    constexpr uint32_t MAX_R = 32, MAX_P = 16;
+
+    bool parseUint(std::string_view text, uint32_t& value) {
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return ec == std::errc() && ptr == text.data() + text.size();
+    }
+
+    // 解析 "key=value"
+    bool parseParam(std::string_view item, std::string_view key, uint32_t& value) {
+        if (item.size() <= key.size() + 1 || item.substr(0, key.size()) != key ||
+            item[key.size()] != '=') {
+            return false;
+        }
+        return parseUint(item.substr(key.size() + 1), value);
+    }
+
+} // namespace
+
+PasswordHasher& PasswordHasher::instance() {
+    static PasswordHasher instance;
+    return instance;
+}
+
+void PasswordHasher::configure(const Json::Value& config) {
+    params_.logN = std::clamp(config.get("scrypt_log_n", 15).asUInt(), MIN_LOG_N, MAX_LOG_N);
+    params_.r = std::clamp(config.get("scrypt_r", 8).asUInt(), 1u, MAX_R);
+    params_.p = std::clamp(config.get("scrypt_p", 1).asUInt(), 1u, MAX_P);
+
+    const auto cores = std::max(2u, std::thread::hardware_concurrency());
+    workers_ = std::max(1u, config.get("workers", cores / 2).asUInt());
+    maxPending_ = std::max(1u, config.get("max_pending", 64).asUInt());
+    pool_ = std::make_unique<WorkerPool>("password hasher", workers_, maxPending_);
+
+    spdlog::info("Password hasher: scrypt N=2^{}, r={}, p={}, workers={}, maxPending={}",
+                 params_.logN, params_.r, params_.p, workers_, maxPending_);
+}
+
+WorkerPool& PasswordHasher::pool() {
+    if (!pool_) {
+        throw core::AppException(core::ErrorCode::OPERATION_FAILED, "password hasher not configured");
+    }
+    return *pool_;
+}
+
+drogon::Task<std::string> PasswordHasher::hash(std::string password, std::string salt) {
+    co_return co_await pool().run(
+        [password = std::move(password), salt = std::move(salt), params = params_]() {
+            return encode(params, derive(password, salt, params));
+        });
+}
+
+drogon::Task<PasswordCheck> PasswordHasher::verify(std::string password, std::string salt,
+                                                   std::string encoded) {
+    Params params;
+    if (!decode(encoded, params)) {
+        // 旧版 sha256：计算量很小，直接在当前线程完成
+        const bool matched = Crypto::constantTimeEquals(
+            Crypto::sha256(salt + password + salt), encoded);
+        co_return PasswordCheck{matched, matched};
+    }
+
+    // 协程在计算完成前保持挂起，按引用捕获参数是安全的
+    const bool matched = co_await pool().run([&password, &salt, &encoded, params]() {
+        return Crypto::constantTimeEquals(encode(params, derive(password, salt, params)), encoded);
+    });
+
+    const bool weaker = params.logN < params_.logN || params.r < params_.r || params.p < params_.p;
+    co_return PasswordCheck{matched, matched && weaker};
+}
+
+std::string PasswordHasher::derive(std::string_view password, std::string_view salt,
+                                   const Params& params) {
+    const uint64_t n = uint64_t{1} << params.logN;
+    // OpenSSL 需要 128 * r * (N + p + 2) 字节工作内存，额外留 1MB 余量
+    const uint64_t maxMem = 128 * uint64_t{params.r} * (n + params.p + 2) + (1 << 20);
+
+    unsigned char out[DIGEST_BYTES];
+    if (EVP_PBE_scrypt(password.data(), password.size(),
+                       reinterpret_cast<const unsigned char*>(salt.data()), salt.size(),
+                       n, params.r, params.p, maxMem, out, sizeof(out)) != 1) {
+        throw core::AppException(core::ErrorCode::OPERATION_FAILED, "scrypt failed");
+    }
+    return std::string(reinterpret_cast<const char*>(out), sizeof(out));
+}
+
+std::string PasswordHasher::encode(const Params& params, std::string_view digest) {
+    char b64[codec::base64EncodedLength(DIGEST_BYTES, false)];
+    const auto len = codec::base64Encode(digest.data(), digest.size(), b64,
+                                         codec::Base64Alphabet::Standard, false);
+    return fmt::format("{}ln={},r={},p={}${}", SCRYPT_PREFIX, params.logN, params.r, params.p,
+                       std::string_view(b64, len));
+}
+
+bool PasswordHasher::decode(std::string_view encoded, Params& params) {
+    if (encoded.substr(0, SCRYPT_PREFIX.size()) != SCRYPT_PREFIX) {
+        return false;
+    }
+    encoded.remove_prefix(SCRYPT_PREFIX.size());
+
+    const auto sep = encoded.find('$');
+    if (sep == std::string_view::npos) {
+        return false;
+    }
+    const auto paramText = encoded.substr(0, sep);
+    const auto digest = encoded.substr(sep + 1);
+
+    const auto c1 = paramText.find(',');
+    const auto c2 = c1 == std::string_view::npos ? c1 : paramText.find(',', c1 + 1);
+    if (c1 == std::string_view::npos || c2 == std::string_view::npos ||
+        !parseParam(paramText.substr(0, c1), "ln", params.logN) ||
+        !parseParam(paramText.substr(c1 + 1, c2 - c1 - 1), "r", params.r) ||
+        !parseParam(paramText.substr(c2 + 1), "p", params.p)) {
+        return false;
+    }
+    return params.logN >= MIN_LOG_N && params.logN <= MAX_LOG_N &&
+           params.r >= 1 && params.r <= MAX_R && params.p >= 1 && params.p <= MAX_P &&
+           !digest.empty();
+}
+
+} // namespace utils
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <drogon/drogon.h>
+#include <json/json.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "WorkerPool.hpp"
+
+namespace utils {
+
+    // 密码校验结果
+    struct PasswordCheck {
+        bool matched{false};
+        bool needsRehash{false};  // 旧格式或参数低于当前配置，登录成功后应重新哈希
+    };
+
+    // 密码哈希（scrypt，在独立的有界线程池上计算，不阻塞 IO 循环）
+    // 存储格式：$scrypt$ln=<log2 N>,r=<r>,p=<p>$<base64 摘要>，盐沿用 users.salt 列
+    // 不带 $scrypt$ 前缀的视为旧版 sha256(salt + password + salt)
+    // 表结构要求：默认参数下存储值为 65 字符，参数取到上限时为 67 字符，
+    // users.password_hash 需不短于 67（建议 VARCHAR(128)），仍为 sha256 长度（64）的列需先扩容，
+    // 否则登录时的哈希升级会被截断或写入失败
+    class PasswordHasher {
+    public:
+        // 单例获取
+        static PasswordHasher& instance();
+
+        // 读取 password_hash 配置并创建线程池（需在 app().run() 之前调用）
+        void configure(const Json::Value& config);
+
+        // 计算哈希；线程池饱和时抛出 RATE_LIMIT_EXCEEDED
+        drogon::Task<std::string> hash(std::string password, std::string salt);
+
+        // 校验密码；线程池饱和时抛出 RATE_LIMIT_EXCEEDED
+        drogon::Task<PasswordCheck> verify(std::string password, std::string salt, std::string encoded);
+
+    private:
+        struct Params {
+            uint32_t logN{15};
+            uint32_t r{8};
+            uint32_t p{1};
+        };
+
+        PasswordHasher() = default;
+        PasswordHasher(const PasswordHasher&) = delete;
+        PasswordHasher& operator=(const PasswordHasher&) = delete;
+
+        WorkerPool& pool();
+
+        static std::string derive(std::string_view password, std::string_view salt, const Params& params);
+        static std::string encode(const Params& params, std::string_view digest);
+        static bool decode(std::string_view encoded, Params& params);
+
+        Params params_;
+        size_t workers_{2};
+        size_t maxPending_{64};
+        std::unique_ptr<WorkerPool> pool_;
+    };
+
+} // namespace utils
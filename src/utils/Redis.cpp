@@ -1,6 +1,9 @@
 #include "Redis.hpp"
 #include "core/Exception.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <utility>
 
 namespace utils {
 
@@ -9,6 +12,23 @@ Redis& Redis::instance() {
     return instance;
 }
 
+Redis Redis::traced(const trace::SpanContext& parent) const {
+    Redis view(*this);
+    view.parent_ = parent;
+    return view;
+}
+
+trace::Span Redis::commandSpan(const char* command) const {
+    if (!parent_.valid()) {
+        return {};
+    }
+    std::string_view text(command);
+    auto name = fmt::format("redis {}", text.substr(0, text.find(' ')));
+    trace::Span span(name, trace::SpanKind::Client, parent_);
+    span.setAttribute("db.system", "redis");
+    return span;
+}
+
 drogon::nosql::RedisClientPtr Redis::client() {
     auto redisClient = drogon::app().getRedisClient();
     if (!redisClient) {
@@ -21,7 +41,7 @@ drogon::nosql::RedisClientPtr Redis::client() {
 drogon::Task<bool> Redis::set(const std::string& key, const std::string& value) {
     try {
         auto redis = client();
-        co_await redis->execCommandCoro("SET %s %s", key.c_str(), value.c_str());
+        co_await exec(redis, "SET %s %s", key.c_str(), value.c_str());
         co_return true;
     } catch (const drogon::nosql::RedisException& e) {
         spdlog::error("Redis SET error: {}", e.what());
@@ -33,10 +53,11 @@ drogon::Task<bool> Redis::setEx(const std::string& key, const std::string& value
                                  std::chrono::seconds ttl) {
     try {
         auto redis = client();
-        co_await redis->execCommandCoro("SETEX %s %d %s",
-                                        key.c_str(),
+        // %b 按长度传参，键 / 值可包含二进制字节
+        co_await exec(redis, "SETEX %b %d %b",
+                                        key.data(), key.size(),
                                         static_cast<int>(ttl.count()),
-                                        value.c_str());
+                                        value.data(), value.size());
         co_return true;
     } catch (const drogon::nosql::RedisException& e) {
         spdlog::error("Redis SETEX error: {}", e.what());
@@ -47,7 +68,7 @@ drogon::Task<bool> Redis::setEx(const std::string& key, const std::string& value
 drogon::Task<std::string> Redis::get(const std::string& key) {
     try {
         auto redis = client();
-        auto result = co_await redis->execCommandCoro("GET %s", key.c_str());
+        auto result = co_await exec(redis, "GET %s", key.c_str());
         if (result.isNil()) {
             co_return "";
         }
@@ -61,7 +82,7 @@ drogon::Task<std::string> Redis::get(const std::string& key) {
 drogon::Task<bool> Redis::del(const std::string& key) {
     try {
         auto redis = client();
-        auto result = co_await redis->execCommandCoro("DEL %s", key.c_str());
+        auto result = co_await exec(redis, "DEL %s", key.c_str());
         co_return result.asInteger() > 0;
     } catch (const drogon::nosql::RedisException& e) {
         spdlog::error("Redis DEL error: {}", e.what());
@@ -72,7 +93,7 @@ drogon::Task<bool> Redis::del(const std::string& key) {
 drogon::Task<bool> Redis::exists(const std::string& key) {
     try {
         auto redis = client();
-        auto result = co_await redis->execCommandCoro("EXISTS %s", key.c_str());
+        auto result = co_await exec(redis, "EXISTS %b", key.data(), key.size());
         co_return result.asInteger() > 0;
     } catch (const drogon::nosql::RedisException& e) {
         spdlog::error("Redis EXISTS error: {}", e.what());
@@ -83,7 +104,7 @@ drogon::Task<bool> Redis::exists(const std::string& key) {
 drogon::Task<bool> Redis::expire(const std::string& key, std::chrono::seconds ttl) {
     try {
         auto redis = client();
-        auto result = co_await redis->execCommandCoro("EXPIRE %s %d",
+        auto result = co_await exec(redis, "EXPIRE %s %d",
                                                       key.c_str(),
                                                       static_cast<int>(ttl.count()));
         co_return result.asInteger() > 0;
@@ -97,7 +118,7 @@ drogon::Task<bool> Redis::hset(const std::string& key, const std::string& field,
                                 const std::string& value) {
     try {
         auto redis = client();
-        co_await redis->execCommandCoro("HSET %s %s %s",
+        co_await exec(redis, "HSET %s %s %s",
                                         key.c_str(), field.c_str(), value.c_str());
         co_return true;
     } catch (const drogon::nosql::RedisException& e) {
@@ -106,4 +127,355 @@ drogon::Task<bool> Redis::hset(const std::string& key, const std::string& field,
     }
 }
 
-drogon::Task<std::string> Redis::hget(const std::string& key, const std::string
\ No newline at end of file
+drogon::Task<std::string> Redis::hget(const std::string& key, const std::string& field) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "HGET %s %s", key.c_str(), field.c_str());
+        if (result.isNil()) {
+            co_return "";
+        }
+        co_return result.asString();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis HGET error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<bool> Redis::hdel(const std::string& key, const std::string& field) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "HDEL %s %s", key.c_str(), field.c_str());
+        co_return result.asInteger() > 0;
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis HDEL error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<int64_t> Redis::lpush(const std::string& key, const std::string& value) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "LPUSH %s %s", key.c_str(), value.c_str());
+        co_return result.asInteger();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis LPUSH error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<std::string> Redis::rpop(const std::string& key) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "RPOP %s", key.c_str());
+        if (result.isNil()) {
+            co_return "";
+        }
+        co_return result.asString();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis RPOP error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<std::string> Redis::brpop(const std::string& key, std::chrono::seconds timeout) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "BRPOP %s %d",
+                                                      key.c_str(),
+                                                      static_cast<int>(timeout.count()));
+        // 超时返回 nil，否则返回 [key, value]
+        if (result.isNil()) {
+            co_return "";
+        }
+        auto items = result.asArray();
+        if (items.size() < 2) {
+            co_return "";
+        }
+        co_return items[1].asString();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis BRPOP error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<int64_t> Redis::llen(const std::string& key) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "LLEN %s", key.c_str());
+        co_return result.asInteger();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis LLEN error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<bool> Redis::lock(const std::string& key, const std::string& value,
+                                std::chrono::seconds ttl) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "SET %s %s NX EX %d",
+                                                      key.c_str(),
+                                                      value.c_str(),
+                                                      static_cast<int>(ttl.count()));
+        // 成功返回 OK，已存在返回 nil
+        co_return !result.isNil();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis LOCK error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<bool> Redis::unlock(const std::string& key, const std::string& value) {
+    // 只删除自己持有的锁
+    static constexpr const char* script =
+        "if redis.call('GET', KEYS[1]) == ARGV[1] then "
+        "return redis.call('DEL', KEYS[1]) "
+        "else return 0 end";
+
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "EVAL %s 1 %s %s",
+                                                      script,
+                                                      key.c_str(),
+                                                      value.c_str());
+        co_return result.asInteger() > 0;
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis UNLOCK error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<bool> Redis::unlockAndNotify(const std::string& key, const std::string& value,
+                                           const std::string& channel, const std::string& message) {
+    // 删除自己持有的锁，并发布释放消息（等待方通过订阅连接接收，不占用命令连接）
+    static constexpr const char* script =
+        "if redis.call('GET', KEYS[1]) == ARGV[1] then "
+        "redis.call('DEL', KEYS[1]) "
+        "redis.call('PUBLISH', ARGV[2], ARGV[3]) "
+        "return 1 "
+        "else return 0 end";
+
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "EVAL %s 1 %s %s %s %s",
+                                                      script,
+                                                      key.c_str(),
+                                                      value.c_str(),
+                                                      channel.c_str(),
+                                                      message.c_str());
+        co_return result.asInteger() > 0;
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis UNLOCK error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<bool> Redis::lockMany(const std::vector<std::string>& keys,
+                                    const std::string& value,
+                                    std::chrono::seconds ttl) {
+    // 全有或全无：任一 key 已存在则不加锁
+    static constexpr const char* script =
+        "for _, key in ipairs(KEYS) do "
+        "if redis.call('EXISTS', key) == 1 then return 0 end "
+        "end "
+        "for _, key in ipairs(KEYS) do "
+        "redis.call('SET', key, ARGV[1], 'EX', ARGV[2]) "
+        "end "
+        "return 1";
+
+    if (keys.size() > MAX_SCRIPT_KEYS) {
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, "too many keys for LOCK");
+    }
+
+    std::vector<std::string> args(keys.begin(), keys.end());
+    args.push_back(value);
+    args.push_back(std::to_string(ttl.count()));
+
+    try {
+        auto result = co_await eval(client(), script, keys.size(), args);
+        co_return result.asInteger() > 0;
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis LOCK error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<int64_t> Redis::unlockMany(const std::vector<std::pair<std::string, std::string>>& keys,
+                                         const std::string& value,
+                                         const std::string& channel) {
+    // 逐个删除自己持有的锁并发布释放消息（KEYS[i] 对应消息 ARGV[2 + i]），返回释放数量
+    static constexpr const char* script =
+        "local released = 0 "
+        "for i, key in ipairs(KEYS) do "
+        "if redis.call('GET', key) == ARGV[1] then "
+        "redis.call('DEL', key) "
+        "redis.call('PUBLISH', ARGV[2], ARGV[2 + i]) "
+        "released = released + 1 "
+        "end "
+        "end "
+        "return released";
+
+    if (keys.size() > MAX_SCRIPT_KEYS) {
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, "too many keys for UNLOCK");
+    }
+
+    std::vector<std::string> args;
+    args.reserve(keys.size() * 2 + 2);
+    for (const auto& entry : keys) {
+        args.push_back(entry.first);
+    }
+    args.push_back(value);
+    args.push_back(channel);
+    for (const auto& entry : keys) {
+        args.push_back(entry.second);
+    }
+
+    try {
+        auto result = co_await eval(client(), script, keys.size(), args);
+        co_return result.asInteger();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis UNLOCK error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<std::vector<std::string>> Redis::renewLeases(
+    const std::vector<std::pair<std::string, std::string>>& leases,
+    std::chrono::milliseconds ttl) {
+    // 比较并续期：值仍匹配才 PEXPIRE，返回已丢失的 key（KEYS[i] 对应值 ARGV[1 + i]）
+    static constexpr const char* script =
+        "local lost = {} "
+        "for i, key in ipairs(KEYS) do "
+        "if redis.call('GET', key) == ARGV[1 + i] then redis.call('PEXPIRE', key, ARGV[1]) "
+        "else table.insert(lost, key) end "
+        "end "
+        "return lost";
+
+    std::vector<std::string> lost;
+    try {
+        auto redis = client();
+        const auto ttlText = std::to_string(ttl.count());
+        // 超出单次脚本的 key 上限时分批，每批一次往返
+        for (size_t offset = 0; offset < leases.size(); offset += MAX_SCRIPT_KEYS) {
+            const auto count = std::min(MAX_SCRIPT_KEYS, leases.size() - offset);
+            std::vector<std::string> args;
+            args.reserve(count * 2 + 1);
+            for (size_t i = 0; i < count; ++i) {
+                args.push_back(leases[offset + i].first);
+            }
+            args.push_back(ttlText);
+            for (size_t i = 0; i < count; ++i) {
+                args.push_back(leases[offset + i].second);
+            }
+
+            auto result = co_await eval(redis, script, count, args);
+            for (const auto& item : result.asArray()) {
+                lost.push_back(item.asString());
+            }
+        }
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis RENEW error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+    co_return lost;
+}
+
+template <size_t N>
+drogon::Task<drogon::nosql::RedisResult> Redis::execArgs(const drogon::nosql::RedisClientPtr& redis,
+                                                         const char* format,
+                                                         const std::vector<std::string>& args) {
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+        return exec(redis, format, args[I].c_str()...);
+    }(std::make_index_sequence<N>{});
+}
+
+drogon::Task<drogon::nosql::RedisResult> Redis::eval(const drogon::nosql::RedisClientPtr& redis,
+                                                     const char* script, size_t numKeys,
+                                                     const std::vector<std::string>& args) {
+    // hiredis 只接受格式化参数：按实际参数个数生成格式串，再分派到对应参数个数的 exec
+    using Exec = drogon::Task<drogon::nosql::RedisResult> (Redis::*)(
+        const drogon::nosql::RedisClientPtr&, const char*, const std::vector<std::string>&);
+    static constexpr auto table = []<size_t... N>(std::index_sequence<N...>) {
+        return std::array<Exec, sizeof...(N)>{&Redis::execArgs<N + 1>...};
+    }(std::make_index_sequence<MAX_EVAL_ARGS>{});
+
+    std::vector<std::string> argv;
+    argv.reserve(args.size() + 1);
+    argv.emplace_back(script);
+    argv.insert(argv.end(), args.begin(), args.end());
+    if (argv.size() > table.size()) {
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, "too many EVAL arguments");
+    }
+
+    std::string format = fmt::format("EVAL %s {}", numKeys);
+    for (size_t i = 1; i < argv.size(); ++i) {
+        format += " %s";
+    }
+    co_return co_await (this->*table[argv.size() - 1])(redis, format.c_str(), argv);
+}
+
+drogon::Task<int64_t> Redis::publish(const std::string& channel, const std::string& message) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "PUBLISH %s %b",
+                                                      channel.c_str(),
+                                                      message.data(), message.size());
+        co_return result.asInteger();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis PUBLISH error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+drogon::Task<std::vector<std::string>> Redis::scanKeys(const std::string& pattern, int batchSize) {
+    std::vector<std::string> keys;
+    std::string cursor = "0";
+
+    try {
+        auto redis = client();
+        do {
+            // SCAN 返回 [next_cursor, [key...]]
+            auto result = co_await exec(redis, "SCAN %s MATCH %s COUNT %d",
+                                                          cursor.c_str(),
+                                                          pattern.c_str(),
+                                                          batchSize);
+            auto reply = result.asArray();
+            if (reply.size() < 2) {
+                break;
+            }
+            cursor = reply[0].asString();
+            for (const auto& item : reply[1].asArray()) {
+                keys.push_back(item.asString());
+            }
+        } while (cursor != "0");
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis SCAN error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+
+    co_return keys;
+}
+
+std::shared_ptr<drogon::nosql::RedisSubscriber> Redis::subscribe(
+    const std::string& channel,
+    std::function<void(const std::string&)> handler) {
+    auto subscriber = client()->newSubscriber();
+    subscriber->subscribe(channel,
+        [handler = std::move(handler)](const std::string&, const std::string& message) {
+            handler(message);
+        });
+    return subscriber;
+}
+
+drogon::Task<int64_t> Redis::incr(const std::string& key) {
+    try {
+        auto redis = client();
+        auto result = co_await exec(redis, "INCR %s", key.c_str());
+        co_return result.asInteger();
+    } catch (const drogon::nosql::RedisException& e) {
+        spdlog::error("Redis INCR error: {}", e.what());
+        throw core::RedisException(core::ErrorCode::REDIS_OPERATION_ERROR, e.what());
+    }
+}
+
+} // namespace utils
\ No newline at end of file
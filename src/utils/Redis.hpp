@@ -3,7 +3,12 @@
 #include <drogon/drogon.h>
 #include <drogon/nosql/RedisClient.h>
 #include <string>
+#include <vector>
+#include <utility>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include "trace/Span.hpp"
 
 namespace utils {
 
@@ -11,9 +16,14 @@ namespace utils {
     public:
         static Redis& instance();
 
+        // 带追踪的视图：命令以 parent 的子 Span 记录（视图需在同一个 co_await 表达式内使用或保存为局部变量）
+        [[nodiscard]] Redis traced(const trace::SpanContext& parent) const;
+
+        ~Redis() = default;
+
         drogon::nosql::RedisClientPtr client();
 
-        // 基础操作
+        // 基础操作（setEx / exists 的键与值二进制安全）
         drogon::Task<bool> set(const std::string& key, const std::string& value);
         drogon::Task<bool> setEx(const std::string& key, const std::string& value,
                                   std::chrono::seconds ttl);
@@ -38,15 +48,70 @@ namespace utils {
         drogon::Task<bool> lock(const std::string& key, const std::string& value,
                                 std::chrono::seconds ttl);
         drogon::Task<bool> unlock(const std::string& key, const std::string& value);
+        // 释放锁并向 channel 发布 message（唤醒其他节点的等待者）
+        drogon::Task<bool> unlockAndNotify(const std::string& key, const std::string& value,
+                                           const std::string& channel, const std::string& message);
+        // 单次脚本最多声明的 key 数（lockMany / unlockMany 超出时抛出，renewLeases 自动分批）
+        static constexpr size_t MAX_SCRIPT_KEYS = 30;
+
+        // 批量加锁（全有或全无）/ 批量释放并通知（keys 为 锁 key + 发布的消息）
+        // key 均以 KEYS 声明，Redis Cluster 下需使用 hash tag 使其落在同一个槽
+        drogon::Task<bool> lockMany(const std::vector<std::string>& keys,
+                                    const std::string& value,
+                                    std::chrono::seconds ttl);
+        drogon::Task<int64_t> unlockMany(const std::vector<std::pair<std::string, std::string>>& keys,
+                                         const std::string& value,
+                                         const std::string& channel);
+        // 批量比较并续期（值不匹配的 key 作为丢失返回）
+        drogon::Task<std::vector<std::string>> renewLeases(
+            const std::vector<std::pair<std::string, std::string>>& leases,
+            std::chrono::milliseconds ttl);
+
+        // 发布 / 订阅
+        drogon::Task<int64_t> publish(const std::string& channel, const std::string& message);
+        // 订阅频道，返回的订阅者需要由调用方持有，释放即退订
+        std::shared_ptr<drogon::nosql::RedisSubscriber> subscribe(
+            const std::string& channel,
+            std::function<void(const std::string&)> handler);
+
+        // 按模式遍历 key（SCAN，非阻塞）
+        drogon::Task<std::vector<std::string>> scanKeys(const std::string& pattern, int batchSize = 1000);
 
         // 原子递增
         drogon::Task<int64_t> incr(const std::string& key);
 
     private:
         Redis() = default;
-        ~Redis() = default;
-        Redis(const Redis&) = delete;
+        Redis(const Redis&) = default;
         Redis& operator=(const Redis&) = delete;
+
+        // 执行命令（有父上下文时记录客户端 Span）
+        template <typename... Args>
+        drogon::Task<drogon::nosql::RedisResult> exec(const drogon::nosql::RedisClientPtr& redis,
+                                                      const char* command, Args... args) {
+            auto span = commandSpan(command);
+            try {
+                co_return co_await redis->execCommandCoro(command, args...);
+            } catch (...) {
+                span.setError();
+                throw;
+            }
+        }
+
+        // EVAL script numKeys args...（args 为 KEYS 与 ARGV 依次排列，二进制不安全，不能含 '\0'）
+        static constexpr size_t MAX_EVAL_ARGS = 64;
+        drogon::Task<drogon::nosql::RedisResult> eval(const drogon::nosql::RedisClientPtr& redis,
+                                                      const char* script, size_t numKeys,
+                                                      const std::vector<std::string>& args);
+
+        template <size_t N>
+        drogon::Task<drogon::nosql::RedisResult> execArgs(const drogon::nosql::RedisClientPtr& redis,
+                                                          const char* format,
+                                                          const std::vector<std::string>& args);
+
+        [[nodiscard]] trace::Span commandSpan(const char* command) const;
+
+        trace::SpanContext parent_;
     };
 
 } // namespace utils
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace utils {
+
+    // 单生产者 / 单消费者无锁环形缓冲区（容量向上取整为 2 的幂）
+    // 生产者与消费者各自缓存对方的位置，只有在看起来满 / 空时才读取对方的原子变量
+    template <typename T>
+    class SpscRing {
+    public:
+        explicit SpscRing(size_t capacity)
+            : buffer_(roundUp(capacity))
+            , mask_(buffer_.size() - 1) {
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        // 生产者：写入，满时返回 false
+        bool tryPush(const T& item) noexcept {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cachedHead_ >= buffer_.size()) {
+                cachedHead_ = head_.load(std::memory_order_acquire);
+                if (tail - cachedHead_ >= buffer_.size()) {
+                    return false;
+                }
+            }
+            buffer_[tail & mask_] = item;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 消费者：取出，空时返回 false
+        bool tryPop(T& out) noexcept {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            if (head == cachedTail_) {
+                cachedTail_ = tail_.load(std::memory_order_acquire);
+                if (head == cachedTail_) {
+                    return false;
+                }
+            }
+            out = buffer_[head & mask_];
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        [[nodiscard]] size_t capacity() const noexcept { return buffer_.size(); }
+
+    private:
+        static size_t roundUp(size_t capacity) {
+            size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            return size;
+        }
+
+        static constexpr size_t CACHE_LINE = 64;
+
+        std::vector<T> buffer_;
+        const size_t mask_;
+
+        alignas(CACHE_LINE) std::atomic<size_t> head_{0};  // 消费者写
+        size_t cachedTail_{0};                              // 消费者本地
+        alignas(CACHE_LINE) std::atomic<size_t> tail_{0};  // 生产者写
+        size_t cachedHead_{0};                              // 生产者本地
+    };
+
+} // namespace utils
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "WorkerPool.hpp"
+#include <drogon/drogon.h>
+#include <algorithm>
+
+namespace utils {
+
+WorkerPool::WorkerPool(std::string name, size_t threads, size_t maxPending)
+    : name_(std::move(name))
+    , maxPending_(std::max<size_t>(1, maxPending)) {
+    threads = std::max<size_t>(1, threads);
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this](std::stop_token stop) {
+            workerLoop(stop);
+        });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    for (auto& worker : workers_) {
+        worker.request_stop();
+    }
+    cv_.notify_all();
+    workers_.clear();
+}
+
+bool WorkerPool::trySubmit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (jobs_.size() >= maxPending_) {
+            return false;
+        }
+        jobs_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+    return true;
+}
+
+size_t WorkerPool::pending() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return jobs_.size();
+}
+
+trantor::EventLoop* WorkerPool::currentLoop() {
+    auto* loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+    return loop ? loop : drogon::app().getLoop();
+}
+
+void WorkerPool::workerLoop(std::stop_token stop) {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            if (!cv_.wait(lk, stop, [this] { return !jobs_.empty(); })) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
+
+} // namespace utils
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <trantor/net/EventLoop.h>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "core/Exception.hpp"
+
+namespace utils {
+
+    // 有界 CPU 线程池：把阻塞计算移出 IO 循环，协程 co_await 等待结果
+    // 排队任务数达到上限时直接拒绝（RATE_LIMIT_EXCEEDED），避免请求风暴把队列无限堆积
+    class WorkerPool {
+    public:
+        // 在线程池上执行 fn，完成后回到发起协程所在的事件循环恢复
+        template <typename F>
+        class RunAwaiter {
+        public:
+            using Result = std::invoke_result_t<F&>;
+
+            RunAwaiter(WorkerPool& pool, F fn)
+                : pool_(pool)
+                , fn_(std::move(fn)) {
+            }
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                auto* loop = currentLoop();
+                // 提交成功后协程可能已在其他线程恢复并销毁（loop 回退到主循环时），之后不能再访问 this
+                const bool submitted = pool_.trySubmit([this, handle, loop]() {
+                    try {
+                        if constexpr (std::is_void_v<Result>) {
+                            fn_();
+                        } else {
+                            result_.emplace(fn_());
+                        }
+                    } catch (...) {
+                        error_ = std::current_exception();
+                    }
+                    loop->queueInLoop([handle]() { handle.resume(); });
+                });
+                if (!submitted) {
+                    rejected_ = true;
+                    return false;
+                }
+                return true;
+            }
+
+            Result await_resume() {
+                if (rejected_) {
+                    throw core::AppException(core::ErrorCode::RATE_LIMIT_EXCEEDED,
+                                             pool_.name() + " saturated");
+                }
+                if (error_) {
+                    std::rethrow_exception(error_);
+                }
+                if constexpr (!std::is_void_v<Result>) {
+                    return std::move(*result_);
+                }
+            }
+
+        private:
+            using Storage = std::conditional_t<std::is_void_v<Result>, bool, Result>;
+
+            WorkerPool& pool_;
+            F fn_;
+            bool rejected_{false};
+            std::optional<Storage> result_;
+            std::exception_ptr error_;
+        };
+
+        WorkerPool(std::string name, size_t threads, size_t maxPending);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // 提交任务；队列已满返回 false
+        bool trySubmit(std::function<void()> job);
+
+        // co_await pool.run(fn)
+        template <typename F>
+        RunAwaiter<F> run(F fn) {
+            return RunAwaiter<F>(*this, std::move(fn));
+        }
+
+        [[nodiscard]] const std::string& name() const noexcept { return name_; }
+        [[nodiscard]] size_t pending() const;
+
+    private:
+        static trantor::EventLoop* currentLoop();
+
+        void workerLoop(std::stop_token stop);
+
+        std::string name_;
+        size_t maxPending_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable_any cv_;
+        std::deque<std::function<void()>> jobs_;
+        std::vector<std::jthread> workers_;
+    };
+
+} // namespace utils